@@ -22,10 +22,17 @@ let field_sigt name mut read write =
 	and setter = mk_val ("set'" ^ name) write in
 	if mut then [ getter; setter ] else [ getter ]
 
-let meth_impl name args wrap call =
+(* `load` binds the ID around the pushs, so that the arguments are not left
+	on the stack if it raises *)
+let meth_impl name args wrap load call =
 	let args = List.mapi (fun i _ -> arg_name i) args
 	and pushs = List.mapi (fun i ti -> ti.push (arg_name i)) args in
-	mk_let name (wrap (mk_fun args (mk_sequence (pushs @ [ call ]))))
+	mk_let name (wrap (mk_fun args (load (mk_sequence (pushs @ [ call ])))))
+
+(* Same as `meth_impl` for fused calls, the arguments are not pushed *)
+let meth_impl_fused name args wrap call =
+	let args = List.mapi (fun i _ -> arg_name i) args in
+	mk_let name (wrap (mk_fun args call))
 
 let field_impl name mut read write =
 	let getter = mk_let ("get'" ^ name) read
@@ -42,10 +49,10 @@ let sigt_item =
 		| `Ret ti	-> ti.type_
 	in
 	function
-	| `Method (name, _, (args, ret))		->
+	| `Method (name, _, (args, ret), _)		->
 		let wrap t = [%type: _ t' -> [%t t]] in
 		[ meth_sigt name args wrap (ret_type ret) ]
-	| `Method_static (name, _, (args, ret))	->
+	| `Method_static (name, _, (args, ret), _)	->
 		[ meth_sigt name args (wrap_no_args args) (ret_type ret) ]
 	| `Field (name, _jname, ti, mut)			->
 		field_sigt name mut
@@ -58,7 +65,8 @@ let sigt_item =
 	| `Constructor (name, args)				->
 		[ meth_sigt name args (wrap_no_args args) [%type: t] ]
 
-(* Generates signature *)
+(* Generates signature
+	The members that have C stubs use their `external` declarations *)
 let class_sigt class_variants fields =
 	Mty.signature @@ [
 
@@ -73,7 +81,11 @@ let class_sigt class_variants fields =
 		[%sigi: val of_obj : 'a Java.obj -> t];
 
 	]
-	@ List.fold_right (fun (field, _) items -> sigt_item field @ items) fields []
+	@ List.fold_right (fun (field, _, stub) items ->
+		match stub with
+		| Some vds	-> List.map Sig.value vds @ items
+		| None		-> sigt_item field @ items
+	) fields []
 
 (* Implementation *)
 let impl_item =
@@ -81,20 +93,29 @@ let impl_item =
 		if args = [] then [%expr (fun () -> [%e body])] else body
 	in
 
-	(* Defines "id" in `body` *)
-	let load_id index load body =
-		let index = Exp.constant (Const.int index) in
-		[%expr
-			let id =
-				let id = Array.unsafe_get __cls [%e index] in
-				if id == Obj.magic 0 then begin
-					let id = [%e load] in
-					Array.unsafe_set __cls [%e index] (Obj.magic id);
-					id
-				end
-				else Obj.magic id
-			in
-			[%e body]]
+	(* Defines "id" in `body`
+		`member` is the `Jclass.member` resolved at init by eager classes
+		and `load` loads the ID lazily otherwise *)
+	let load_id eager add_global member load =
+		let index = Exp.constant (Const.int (add_global member)) in
+		if eager then
+			fun body ->
+				[%expr
+					let id = Obj.magic (Array.unsafe_get __cls [%e index]) in
+					[%e body]]
+		else
+			fun body ->
+				[%expr
+					let id =
+						let id = Array.unsafe_get __cls [%e index] in
+						if id == Obj.magic 0 then begin
+							let id = [%e load] in
+							Array.unsafe_set __cls [%e index] (Obj.magic id);
+							id
+						end
+						else Obj.magic id
+					in
+					[%e body]]
 
 	(* Defines "cls" in `body`,
 		assumes the class is loaded (do not call __class) *)
@@ -103,37 +124,83 @@ let impl_item =
 	in
 
 	(* Expects an "id" binding the method ID *)
-	let meth_call static ret =
-		match static, ret with
-		| false, `Void		-> [%expr Jcall.call_void obj id]
-		| true, `Void		-> [%expr Jcall.call_static_void cls id]
-		| false, `Ret ti	-> ti.call
-		| true, `Ret ti		-> ti.call_static
+	let meth_call static blocking ret =
+		match static, blocking, ret with
+		| false, false, `Void	-> [%expr Jcall.call_void obj id]
+		| true, false, `Void	-> [%expr Jcall.call_static_void cls id]
+		| false, true, `Void	-> [%expr Jcall.call_blocking_void obj id]
+		| true, true, `Void		->
+			[%expr Jcall.call_static_blocking_void cls id]
+		| false, false, `Ret ti	-> ti.call
+		| true, false, `Ret ti	-> ti.call_static
+		| false, true, `Ret ti	-> ti.call_blocking
+		| true, true, `Ret ti	-> ti.call_static_blocking
+	in
+
+	(* Calls one of the fused externals (eg. `Jcall.call_int_io`)
+		Returns None if there is no fused external for the signature *)
+	let fused_call static blocking args ret =
+		let fused_arg i ti =
+			match ti.fused_arg with
+			| Some (code, conv)	-> code, conv (arg_name i)
+			| None				-> raise Exit
+		and fused_ret =
+			match ret with
+			| `Void		-> Some ("void", fun e -> e)
+			| `Ret ti	-> ti.fused_ret
+		in
+		match fused_ret with
+		| Some (suffix, conv_of) when not blocking
+				&& args <> [] && List.length args <= 2 ->
+			begin try
+				let args = List.mapi fused_arg args in
+				let codes = String.concat "" (List.map fst args)
+				and prefix, target =
+					if static then "call_static_", "cls" else "call_", "obj" in
+				let f = mk_dot (Lident "Jcall") (prefix ^ suffix ^ "_" ^ codes)
+				and args = mk_ident [ target ] :: mk_ident [ "id" ]
+					:: List.map snd args in
+				Some (conv_of (Exp.apply f
+					(List.map (fun e -> Asttypes.Nolabel, e) args)))
+			with Exit -> None
+			end
+		| _ -> None
 	in
 
-	fun add_global ->
+	fun eager add_global ->
+	let load_id = load_id eager add_global in
 	function
-	| `Method (name, jname, (args, ret as sigt))		->
-		let index = add_global ()
-		and sigt = opti_string_concat (Type_info.meth_sigt sigt) in
-		let load = load_id index
+	| `Method (name, jname, (args, ret as sigt), blocking)	->
+		let sigt = opti_string_concat (Type_info.meth_sigt sigt) in
+		let load = load_id
+			[%expr Jclass.Meth ([%e mk_cstr jname], [%e sigt])]
 			[%expr Jclass.get_meth (__class ())
 				[%e mk_cstr jname] [%e sigt]]
 		and wrap body = [%expr (fun obj -> [%e body])] in
-		[ meth_impl name args wrap (load (meth_call false ret)) ]
-
-	| `Method_static (name, jname, (args, ret as sigt))	->
-		let index = add_global ()
-		and sigt = opti_string_concat (Type_info.meth_sigt sigt) in
-		let load body = load_id index
+		begin match fused_call false blocking args ret with
+		| Some call	-> [ meth_impl_fused name args wrap (load call) ]
+		| None		->
+			[ meth_impl name args wrap load (meth_call false blocking ret) ]
+		end
+
+	| `Method_static (name, jname, (args, ret as sigt), blocking)	->
+		let sigt = opti_string_concat (Type_info.meth_sigt sigt) in
+		let load_id = load_id
+			[%expr Jclass.Meth_static ([%e mk_cstr jname], [%e sigt])]
 			[%expr Jclass.get_meth_static (__class ())
-				[%e mk_cstr jname] [%e sigt]]
-			(load_cls_unsafe body) in
-		[ meth_impl name args (wrap_no_args args) (load (meth_call true ret)) ]
+				[%e mk_cstr jname] [%e sigt]] in
+		let load body = load_id (load_cls_unsafe body) in
+		begin match fused_call true blocking args ret with
+		| Some call	-> [ meth_impl_fused name args (wrap_no_args args) (load call) ]
+		| None		->
+			[ meth_impl name args (wrap_no_args args) load
+				(meth_call true blocking ret) ]
+		end
 
 	| `Field (name, jname, ti, mut)			->
-		let index = add_global () in
-		let load = load_id index
+		let load = load_id
+			[%expr Jclass.Field ([%e mk_cstr jname],
+				[%e opti_string_concat ti.sigt])]
 			[%expr Jclass.get_field (__class ())
 				[%e mk_cstr jname] [%e ti.sigt]] in
 		field_impl name mut
@@ -141,64 +208,89 @@ let impl_item =
 			[%expr (fun obj v -> [%e load ti.write_field])]
 
 	| `Field_static (name, jname, ti, mut)	->
-		let index = add_global () in
-		let load body = load_id index
+		let load_id = load_id
+			[%expr Jclass.Field_static ([%e mk_cstr jname],
+				[%e opti_string_concat ti.sigt])]
 			[%expr Jclass.get_field_static (__class ())
-				[%e mk_cstr jname] [%e ti.sigt]]
-				(load_cls_unsafe body) in
+				[%e mk_cstr jname] [%e ti.sigt]] in
+		let load body = load_id (load_cls_unsafe body) in
 		field_impl name mut
 			[%expr (fun () -> [%e load ti.read_field_static])]
 			[%expr (fun v -> [%e load ti.write_field_static])]
 
 	| `Constructor (name, args)				->
-		let index = add_global ()
-		and sigt = opti_string_concat
+		let sigt = opti_string_concat
 			[%expr "(" ^ [%e concat_sigt args] ^ ")V"] in
-		let load body = load_id index
+		let load_id = load_id
+			[%expr Jclass.Meth ("<init>", [%e sigt])]
 			[%expr Jclass.get_constructor (__class ())
-				[%e sigt]]
-			(load_cls_unsafe body) in
-		[ meth_impl name args (wrap_no_args args)
-			(load [%expr Jcall.new_ cls id]) ]
-
-(* Generates implementation *)
-let class_impl path_name class_variants fields =
-	(* Use a ref to count globals from `impl_item` *)
-	let global_count = ref 1 in
-	let add_global () =
+				[%e sigt]] in
+		let load body = load_id (load_cls_unsafe body) in
+		[ meth_impl name args (wrap_no_args args) load
+			[%expr Jcall.new_ cls id] ]
+
+(* Generates implementation
+	If `eager`, the class and its members are resolved at module init
+	(see `Jclass.resolve_all`), otherwise they are loaded on first use
+	`stubs_init` are the items that initialize the C stubs, if any *)
+let class_impl eager stubs_init path_name class_variants fields =
+	(* Use a ref to count globals from `impl_item`
+		and collect their `Jclass.member`, in the order of the indexes *)
+	let global_count = ref 1
+	and members = ref [] in
+	let add_global member =
 		let id = !global_count in
 		incr global_count;
+		members := member :: !members;
 		id
 	in
 
 	(* Items *)
-	let items = List.fold_right (fun (field, loc) items ->
-		Ast_helper.with_default_loc loc
-			(fun () -> impl_item add_global field)
-		@ items
+	let items = List.fold_right (fun (field, loc, stub) items ->
+		match stub with
+		| Some vds	-> List.map Str.primitive vds @ items
+		| None		->
+			Ast_helper.with_default_loc loc
+				(fun () -> impl_item eager add_global field)
+			@ items
 	) fields [] in
 
 	(* Intro *)
-	let cls_array = Array.(make !global_count [%expr Obj.magic 0] |> to_list)
-	and class_name = mk_cstr path_name in
+	let class_name = mk_cstr path_name in
+	let load_class =
+		if eager then
+			let members = Exp.array (List.rev !members) in
+			[
+				[%stri let __cls : Jclass.t array =
+					Jclass.resolve_all [%e class_name] [%e members]];
+
+				[%stri let __class () = Array.unsafe_get __cls 0]
+			]
+		else
+			let cls_array =
+				Array.(make !global_count [%expr Obj.magic 0] |> to_list) in
+			[
+				[%stri let __cls : Jclass.t array = [%e Exp.array cls_array]];
+
+				[%stri let __class () =
+					let cls = Array.unsafe_get __cls 0 in
+					if cls == Obj.magic 0 then begin
+						let cls = Jclass.find_class [%e class_name] in
+						Array.unsafe_set __cls 0 cls;
+						cls
+					end
+					else cls]
+			]
+	in
 	let items = [
 
 		[%stri type c = [%t class_variants]];
 		[%stri type 'a t' = ([> c] as 'a) Java.obj];
 		[%stri type t = c Java.obj];
 
-		[%stri let __class_name () = [%e class_name]];
+		[%stri let __class_name () = [%e class_name]]
 
-		[%stri let __cls : Jclass.t array = [%e Exp.array cls_array]];
-
-		[%stri let __class () =
-			let cls = Array.unsafe_get __cls 0 in
-			if cls == Obj.magic 0 then begin
-				let cls = Jclass.find_class [%e class_name] in
-				Array.unsafe_set __cls 0 cls;
-				cls
-			end
-			else cls];
+	] @ load_class @ stubs_init @ [
 
 		[%stri external of_obj_unsafe : 'a Java.obj -> t = "%identity"];
 
@@ -211,9 +303,22 @@ let class_impl path_name class_variants fields =
 
 	Mod.structure items
 
-(* Module sigt and impl *)
-let class_ class_name path_name class_variants fields =
-	let impl = class_impl path_name class_variants fields
+(* Module sigt and impl
+	If `stubs`, the members that support it are bound to C stubs
+	(see `Stubs`) *)
+let class_ ~eager ~stubs class_name path_name class_variants fields =
+	let fields, stubs_init =
+		if stubs then
+			let t = Stubs.create path_name in
+			let fields = List.map (fun (field, loc) ->
+				field, loc,
+				Ast_helper.with_default_loc loc (fun () -> Stubs.member t field)
+			) fields in
+			fields, Stubs.finish t
+		else
+			List.map (fun (field, loc) -> field, loc, None) fields, []
+	in
+	let impl = class_impl eager stubs_init path_name class_variants fields
 	and sigt = class_sigt class_variants fields in
 	let mn = String.capitalize_ascii class_name in
 	Mb.mk (mk_loc mn) (Mod.constraint_ impl sigt)
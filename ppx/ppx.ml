@@ -12,18 +12,38 @@ open Ast_tools
 	Raises a location error if the type is not supported *)
 let rec translate_type class_name java_path rec_classes polymorphic =
 	let no_conv expr = expr in
-	let type_info ?(conv_to=no_conv) ?(conv_of=no_conv) sigt suffix
+	let rec type_info ?(conv_to=no_conv) ?(conv_of=no_conv) sigt suffix
 			?(push_suffix=suffix) type_ =
 		let id prefix = mk_dot (Lident "Jcall") (prefix ^ suffix)
-		and push = mk_dot (Lident "Jcall") ("push_" ^ push_suffix) in
+		and push = mk_dot (Lident "Jcall") ("push_" ^ push_suffix)
+		and fused_arg = match push_suffix with
+			| "int"		-> Some "i"
+			| "object"	-> Some "o"
+			| _			-> None
+		and fused_ret = match suffix with
+			| "int" | "bool" | "object" | "string"	-> Some suffix
+			| _										-> None
+		and local = match suffix with
+			| "object"	->
+				Some (type_info ~conv_to ~conv_of sigt "object_local" ~push_suffix
+					type_)
+			| _			-> None
+		and stub =
+			if conv_to == no_conv && conv_of == no_conv && push_suffix = suffix
+			then Some suffix
+			else None
+		in
 		Type_info.create
 			~push
 			~call:(id "call_")
 			~call_static:(id "call_static_")
+			~call_blocking:(id "call_blocking_")
+			~call_static_blocking:(id "call_static_blocking_")
 			~read_field:(id "read_field_")
 			~write_field:(id "write_field_")
 			~read_field_static:(id "read_field_static_")
 			~write_field_static:(id "write_field_static_")
+			~fused_arg ~fused_ret ?local ?stub
 			sigt type_ conv_to conv_of
 	in
 
@@ -58,6 +78,10 @@ let rec translate_type class_name java_path rec_classes polymorphic =
 		type_info ~conv_of ~conv_to sigt "object" type_
 	in
 
+	let is_interned attrs =
+		Unwrap.has_attr "java.interned" attrs || Unwrap.has_attr "interned" attrs
+	in
+
 	let mn =
 		function
 		| Lident cn when cn = class_name ->
@@ -93,6 +117,9 @@ let rec translate_type class_name java_path rec_classes polymorphic =
 	| [%type: char] as t			-> ti "C" "char" t
 	| [%type: float] as t			-> ti "F" "float" t
 	| [%type: double]				-> ti "D" "double" [%type: float]
+	| { ptyp_desc = Ptyp_constr ({ txt = Lident "string"; _ }, []);
+			ptyp_attributes; _ } when is_interned ptyp_attributes ->
+		ti "Ljava/lang/String;" "string_interned" [%type: string]
 	| [%type: string] as t			-> ti "Ljava/lang/String;" "string" t
 	| [%type: string option] as t	-> ti "Ljava/lang/String;" "string_opt" t
 	| [%type: [%t? _] Java.obj] as t -> ti "Ljava/lang/Object;" "object" t
@@ -152,17 +179,22 @@ let rec translate_type class_name java_path rec_classes polymorphic =
 let translate_field class_name java_path rec_classes =
 	let transl_type = translate_type class_name java_path rec_classes in
 	let transl_args = List.map (transl_type true)
-	and transl_ret =
+	and transl_local local t =
+		let ti = transl_type false t in
+		if local then Type_info.to_local ~loc:t.ptyp_loc ti else ti
+	in
+	let transl_ret local =
 		function
-		| [%type: unit]	-> `Void
-		| t				-> `Ret (transl_type false t)
+		| [%type: unit] when not local	-> `Void
+		| t								-> `Ret (transl_local local t)
 	in
 	function
-	| `Method (name, java_name, (args, ret), static)	->
-		let m = name, java_name, (transl_args args, transl_ret ret) in
+	| `Method (name, java_name, (args, ret), static, blocking, local)	->
+		let ret = transl_ret local ret in
+		let m = name, java_name, (transl_args args, ret), blocking in
 		if static then `Method_static m else `Method m
-	| `Field (name, java_name, typ, mut, static)		->
-		let f = name, java_name, transl_type false typ, mut in
+	| `Field (name, java_name, typ, mut, static, local)	->
+		let f = name, java_name, transl_local local typ, mut in
 		if static then `Field_static f else `Field f
 	| `Constructor (name, args)							->
 		`Constructor (name, transl_args args)
@@ -187,18 +219,19 @@ let class_variants java_path rec_classes supers =
 let classes cls =
 	let java_path_fmt = String.map (function '.' -> '/' | c -> c) in
 	let unwrap cls =
-		let name, java_path, supers, fields = Unwrap.class_ cls in
-		name, java_path_fmt java_path, supers, fields
+		let name, java_path, supers, fields, eager, stubs = Unwrap.class_ cls in
+		name, java_path_fmt java_path, supers, fields, eager, stubs
 	in
 	let cls = List.map unwrap cls in
-	let rec_classes = List.map (fun (n, p, _, _) -> n, p) cls in
-	let gen (name, java_path, supers, fields) =
+	let rec_classes = List.map (fun (n, p, _, _, _, _) -> n, p) cls in
+	let gen (name, java_path, supers, fields, eager, stubs) =
 		let transl (field, loc) =
 			translate_field name java_path rec_classes field, loc
 		and class_variants =
 			class_variants java_path rec_classes supers
 		in
-		Gen.class_ name java_path class_variants (List.map transl fields)
+		Gen.class_ ~eager ~stubs name java_path class_variants
+			(List.map transl fields)
 	in
 	List.map gen cls
 
@@ -218,5 +251,9 @@ let structure_item mapper =
 let mapper _ _ = { default_mapper with structure_item }
 
 let () =
-	Driver.register ~name:"ocaml-java-ppx" (module OCaml_406) mapper;
+	let args = [
+		"-java-stubs", Arg.String Stubs.set_output,
+			"<file> Write the C stubs of the [@java.stubs] classes to <file>"
+	] in
+	Driver.register ~name:"ocaml-java-ppx" ~args (module OCaml_406) mapper;
 	Driver.run_main ()
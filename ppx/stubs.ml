@@ -0,0 +1,348 @@
+open Parsetree
+open Ast_helper
+open Ast_tools
+open Type_info
+
+(** Dedicated C stubs for the classes with the `[@java.stubs]` attribute
+	Each method, field and constructor is bound by an `external`
+		to a generated C function that calls JNI directly:
+		the IDs are static variables resolved when the module is initialized
+		and the arguments are converted inline, unboxed when possible
+	The C code is written to the file given by the `-java-stubs` option
+		(see `ocamljava_stubs.h` for the functions it uses)
+	Members that cannot have a stub use the `Jcall` functions:
+		types with a convertion on the OCaml side (eg. runnable, arrays),
+		signatures not known by the ppx (classes of other modules),
+		blocking and local calls *)
+
+(* A type in the stubs
+	`jname` is the type part of the JNI functions names (eg. "Int")
+	`jtype` the JNI type and `dst` the field of the `jvalue` union
+	`ctype` the type in the native stub, `attr` its attribute
+		("untagged" or "unboxed") if it is not `value`
+	`of_value`/`to_value` convert between `value` and `ctype`
+		in the bytecode stub
+	`to_java`/`of_java` convert between `ctype` and `jtype`
+	`prim` is true if the convertions do not allocate or create local refs *)
+type kind = {
+	jname : string;
+	jtype : string;
+	dst : string;
+	ctype : string;
+	attr : string option;
+	of_value : string -> string;
+	to_value : string -> string;
+	to_java : string -> string;
+	of_java : string -> string;
+	prim : bool
+}
+
+let kind_of_suffix =
+	let call f x = Printf.sprintf "%s(%s)" f x
+	and cast t x = Printf.sprintf "(%s)%s" t x
+	and call_env f x = Printf.sprintf "%s(env, %s)" f x
+	and call_mark f x = Printf.sprintf "%s(env, %s, mark)" f x
+	and no_conv x = x in
+	let untagged jname jtype dst = {
+		jname; jtype; dst; ctype = "intnat"; attr = Some "untagged";
+		of_value = call "Long_val"; to_value = call "Val_long";
+		to_java = cast jtype; of_java = cast "intnat"; prim = true }
+	and unboxed jname jtype dst ctype of_value to_value = {
+		jname; jtype; dst; ctype; attr = Some "unboxed";
+		of_value = call of_value; to_value = call to_value;
+		to_java = cast jtype; of_java = cast ctype; prim = true }
+	and boxed jname jtype dst to_java of_java prim = {
+		jname; jtype; dst; ctype = "value"; attr = None;
+		of_value = no_conv; to_value = no_conv; to_java; of_java; prim }
+	in
+	function
+	| "int"		-> Some (untagged "Int" "jint" "i")
+	| "byte"	-> Some (untagged "Byte" "jbyte" "b")
+	| "short"	-> Some (untagged "Short" "jshort" "s")
+	| "int32"	->
+		Some (unboxed "Int" "jint" "i" "int32_t" "Int32_val" "caml_copy_int32")
+	| "long"	->
+		Some (unboxed "Long" "jlong" "j" "int64_t" "Int64_val" "caml_copy_int64")
+	| "float"	->
+		Some (unboxed "Float" "jfloat" "f" "double" "Double_val"
+			"caml_copy_double")
+	| "double"	->
+		Some (unboxed "Double" "jdouble" "d" "double" "Double_val"
+			"caml_copy_double")
+	| "bool"	->
+		Some (boxed "Boolean" "jboolean" "z" (call "Bool_val") (call "Val_bool")
+			true)
+	| "char"	->
+		Some (boxed "Char" "jchar" "c" (fun x -> cast "jchar" (call "Long_val" x))
+			(call "Val_long") true)
+	| "string"	->
+		Some (boxed "Object" "jobject" "l" (call_env "ocaml_java__stub_string")
+			(call_env "ocaml_java__stub_of_string") false)
+	| "object"	->
+		Some (boxed "Object" "jobject" "l" (call_mark "ocaml_java__stub_obj")
+			(call_env "ocaml_java__stub_of_obj") false)
+	| _			-> None
+
+(* The stubs of a class
+	`decls` holds the static IDs, `code` the stubs
+	and `init` the body of the init stub *)
+type t = {
+	prefix : string;
+	java_path : string;
+	decls : Buffer.t;
+	code : Buffer.t;
+	init : Buffer.t
+}
+
+(* The stubs of every class, written at exit *)
+let buffer = Buffer.create 4096
+
+let set_output file =
+	at_exit (fun () ->
+		let oc = open_out file in
+		output_string oc "/* Generated by ocamljava-ppx */\n\n";
+		output_string oc "#include <ocamljava_stubs.h>\n";
+		Buffer.output_buffer oc buffer;
+		close_out oc)
+
+let mangle = String.map (function
+	| 'a'..'z' | 'A'..'Z' | '0'..'9' as c	-> c
+	| _										-> '_')
+
+let create java_path =
+	let b () = Buffer.create 256 in
+	{ prefix = "ocamljava_stub_" ^ mangle java_path; java_path;
+		decls = b (); code = b (); init = b () }
+
+(* Raised when a member cannot have a stub *)
+exception Unsupported
+
+let kind ti =
+	match ti.stub with
+	| Some suffix	->
+		begin match kind_of_suffix suffix with
+		| Some k	-> k
+		| None		-> raise Unsupported
+		end
+	| None			-> raise Unsupported
+
+let const_sigt e =
+	match (opti_string_concat e).pexp_desc with
+	| Pexp_constant (Pconst_string (s, None))	-> s
+	| _											-> raise Unsupported
+
+(* Type of an argument or a result in the `external` *)
+let ext_type k ti =
+	match k.attr with
+	| Some attr	-> Typ.attr ti.type_ (mk_loc attr, PStr [])
+	| None		-> ti.type_
+
+(* Declares an ID and resolves it in the init stub *)
+let add_id t id_type id resolve name sigt static =
+	Printf.bprintf t.decls "static %s %s;\n" id_type id;
+	Printf.bprintf t.init "\t%s = %s(env, %s__class, \"%s\", \"%s\", %d);\n"
+		id resolve t.prefix (String.escaped name) (String.escaped sigt)
+		(if static then 1 else 0)
+
+(* Generates the native stub `cname` and its bytecode version
+	`params` is the list of (name, kind), `None` for `value` parameters
+	`ret` is the kind of the result, `None` for `value` results
+	`body` is the list of C statements, the last one returns *)
+let gen_function t cname params ret body =
+	let ctype = function Some k -> k.ctype | None -> "value"
+	and of_value (p, k) = match k with Some k -> k.of_value p | None -> p
+	and to_value = match ret with Some k -> k.to_value | None -> (fun x -> x) in
+	let native_params = List.map (fun (p, k) -> ctype k ^ " " ^ p) params in
+	Printf.bprintf t.code "\n%s %s(%s)\n{\n%s}\n"
+		(ctype ret) cname (String.concat ", " native_params)
+		(String.concat "" (List.map (function
+			| ""	-> "\n"
+			| s		-> "\t" ^ s ^ "\n") body));
+	let args, byte_params =
+		if List.length params > 5 then
+			List.mapi (fun i (_, k) -> of_value (Printf.sprintf "argv[%d]" i, k))
+				params,
+			"value *argv, int argn"
+		else
+			List.map of_value params,
+			String.concat ", " (List.map (fun (p, _) -> "value " ^ p) params)
+	in
+	Printf.bprintf t.code "\nvalue %s_byte(%s)\n{\n\treturn %s;\n}\n"
+		cname byte_params
+		(to_value (Printf.sprintf "%s(%s)" cname (String.concat ", " args)))
+
+(* The local variables and the argument array of a call *)
+let call_args args =
+	let n = List.length args in
+	let decls = [ "JNIEnv *const\tenv = ocaml_java__env();";
+			"int const\t\tmark = ocaml_java__stub_enter();" ]
+		@ (if n > 0 then [ Printf.sprintf "jvalue\t\t\targs[%d];" n ] else [])
+	and fill = List.mapi (fun i (p, k) ->
+			Printf.sprintf "args[%d].%s = %s;" i k.dst (k.to_java p)) args in
+	decls, fill, (if n > 0 then "args" else "NULL")
+
+let null_check = [ "if (obj == Val_long(0))"; "\tocaml_java__stub_null();" ]
+
+let arg_name = Printf.sprintf "x%d"
+
+let external_ name cname ?(noalloc=false) type_ =
+	let attrs = if noalloc then [ mk_loc "noalloc", PStr [] ] else [] in
+	Val.mk (mk_loc name) ~attrs ~prim:[ cname ^ "_byte"; cname ] type_
+
+(* Method and constructor stubs
+	`ret` is the kind of the result, `None` for `void` *)
+let meth t name jname args ret ret_type sigt ~static ~constructor =
+	let cname = t.prefix ^ "__" ^ mangle name in
+	let id = cname ^ "__id"
+	and args' = List.mapi (fun i ti -> arg_name i, kind ti) args in
+	add_id t "jmethodID" id "ocaml_java__stub_method" jname sigt
+		(static && not constructor);
+	let decls, fill, jargs = call_args args' in
+	let decls = match ret with
+		| Some k	-> decls @ [ k.jtype ^ "\t\t\tres;" ]
+		| None		-> decls
+	and target =
+		if static then t.prefix ^ "__class"
+		else "ocaml_java__stub_obj(env, obj, mark)"
+	and jcall = match ret with
+		| _ when constructor	-> "NewObjectA"
+		| Some k when static	-> "CallStatic" ^ k.jname ^ "MethodA"
+		| Some k				-> "Call" ^ k.jname ^ "MethodA"
+		| None when static		-> "CallStaticVoidMethodA"
+		| None					-> "CallVoidMethodA"
+	and return = match ret with
+		| Some k	-> "return " ^ k.of_java "res" ^ ";"
+		| None		-> "return Val_unit;"
+	and unboxed k = match k.attr with Some _ -> Some k | None -> None in
+	let call = Printf.sprintf "%s(*env)->%s(env, %s, %s, %s);"
+		(match ret with Some _ -> "res = " | None -> "") jcall target id jargs
+	and params = List.map (fun (p, k) -> p, unboxed k) args'
+	and arg_types = List.map (fun ti -> ext_type (kind ti) ti) args in
+	let params, type_ =
+		if static then
+			(if params = [] then [ "unit", None ] else params),
+			(if args = [] then [%type: unit -> [%t ret_type]]
+			else mk_arrow arg_types ret_type)
+		else
+			("obj", None) :: params,
+			[%type: _ t' -> [%t mk_arrow arg_types ret_type]]
+	and ret_param = match ret with Some k -> unboxed k | None -> None in
+	gen_function t cname params ret_param
+		(decls @ [ "" ] @ (if static then [] else null_check) @ fill
+			@ [ call; "ocaml_java__stub_leave(mark);"; return ]);
+	[ external_ name cname type_ ]
+
+(* Getter and setter stubs *)
+let field t name jname ti mut ~static =
+	let k = kind ti in
+	let sigt = const_sigt ti.sigt
+	and id = t.prefix ^ "__field_" ^ mangle name
+	and get_cname = t.prefix ^ "__get_" ^ mangle name
+	and set_cname = t.prefix ^ "__set_" ^ mangle name
+	and type_ = ext_type k ti
+	and param = if k.attr = None then None else Some k
+	and noalloc = static && k.prim in
+	add_id t "jfieldID" id "ocaml_java__stub_field" jname sigt static;
+	let env = if noalloc
+		then "JNIEnv *const\tenv = ocaml_java__env_noraise();"
+		else "JNIEnv *const\tenv = ocaml_java__env();"
+	and mark = "int const\t\tmark = ocaml_java__stub_enter();" in
+	let getter =
+		if static then begin
+			gen_function t get_cname [ "unit", None ] param [ env;
+				Printf.sprintf
+					"%s const\tres = (*env)->GetStatic%sField(env, %s__class, %s);"
+					k.jtype k.jname t.prefix id;
+				"";
+				"return " ^ k.of_java "res" ^ ";" ];
+			external_ ("get'" ^ name) get_cname ~noalloc [%type: unit -> [%t type_]]
+		end
+		else begin
+			gen_function t get_cname [ "obj", None ] param ([ env; mark;
+				k.jtype ^ "\t\t\tres;"; "" ] @ null_check @ [
+				Printf.sprintf
+					"res = (*env)->Get%sField(env, ocaml_java__stub_obj(env, obj, mark), %s);"
+					k.jname id;
+				"ocaml_java__stub_leave(mark);";
+				"return " ^ k.of_java "res" ^ ";" ]);
+			external_ ("get'" ^ name) get_cname [%type: _ t' -> [%t type_]]
+		end
+	and setter () =
+		if static then begin
+			let set = Printf.sprintf
+				"(*env)->SetStatic%sField(env, %s__class, %s, %s);"
+				k.jname t.prefix id (k.to_java "v") in
+			gen_function t set_cname [ "v", param ] None
+				(if k.prim then [ env; ""; set; "return Val_unit;" ]
+				else [ env; mark; ""; set; "ocaml_java__stub_leave(mark);";
+					"return Val_unit;" ]);
+			external_ ("set'" ^ name) set_cname ~noalloc
+				[%type: [%t type_] -> unit]
+		end
+		else begin
+			gen_function t set_cname [ "obj", None; "v", param ] None
+				([ env; mark; "" ] @ null_check @ [
+				Printf.sprintf
+					"(*env)->Set%sField(env, ocaml_java__stub_obj(env, obj, mark), %s, %s);"
+					k.jname id (k.to_java "v");
+				"ocaml_java__stub_leave(mark);";
+				"return Val_unit;" ]);
+			external_ ("set'" ^ name) set_cname
+				[%type: _ t' -> [%t type_] -> unit]
+		end
+	in
+	if mut then [ getter; setter () ] else [ getter ]
+
+let ret_kind =
+	function
+	| `Void		-> None, [%type: unit]
+	| `Ret ti	-> let k = kind ti in Some k, ext_type k ti
+
+let meth_sigt sigt = const_sigt (Type_info.meth_sigt sigt)
+
+(** Generates the stubs of a member
+	Returns the `external` declarations
+	or `None` if the member must use the `Jcall` functions *)
+let member t m =
+	let snapshot = List.map Buffer.length [ t.decls; t.code; t.init ] in
+	try
+		Some (match m with
+			| `Method (_, _, _, true)
+			| `Method_static (_, _, _, true)			-> raise Unsupported
+			| `Method (name, jname, (args, ret as sigt), false)	->
+				let ret, ret_type = ret_kind ret in
+				meth t name jname args ret ret_type (meth_sigt sigt)
+					~static:false ~constructor:false
+			| `Method_static (name, jname, (args, ret as sigt), false)	->
+				let ret, ret_type = ret_kind ret in
+				meth t name jname args ret ret_type (meth_sigt sigt)
+					~static:true ~constructor:false
+			| `Constructor (name, args)					->
+				let sigt = const_sigt [%expr "(" ^ [%e concat_sigt args] ^ ")V"] in
+				meth t name "<init>" args (kind_of_suffix "object") [%type: t] sigt
+					~static:true ~constructor:true
+			| `Field (name, jname, ti, mut)				->
+				field t name jname ti mut ~static:false
+			| `Field_static (name, jname, ti, mut)		->
+				field t name jname ti mut ~static:true)
+	with Unsupported ->
+		(* Discard what may have been generated *)
+		List.iter2 Buffer.truncate [ t.decls; t.code; t.init ] snapshot;
+		None
+
+(** Writes the stubs of the class
+	and returns the items that call the init stub *)
+let finish t =
+	Printf.bprintf buffer "\n/*\n** %s\n*/\n\nstatic jclass %s__class;\n%s%s"
+		t.java_path t.prefix (Buffer.contents t.decls) (Buffer.contents t.code);
+	Printf.bprintf buffer "\nvalue %s__init(value unit)\n{\n\
+		\tJNIEnv *const\tenv = ocaml_java__env();\n\n\
+		\t%s__class = ocaml_java__stub_class(env, \"%s\");\n%s\
+		\treturn Val_unit;\n\t(void)unit;\n}\n"
+		t.prefix t.prefix (String.escaped t.java_path) (Buffer.contents t.init);
+	let init = t.prefix ^ "__init" in
+	[
+		Str.primitive (Val.mk (mk_loc "__stubs_init") ~prim:[ init ]
+			[%type: unit -> unit]);
+		[%stri let () = __stubs_init ()]
+	]
@@ -67,3 +67,27 @@ object
 	method float_value : float = "floatValue"
 	method [@static] of_string : jstring -> jfloat = "valueOf"
 end
+
+class%java thread "java.lang.Thread" =
+object
+	method [@java.blocking] join : unit = "join"
+	method [@java.blocking] join_millis : long -> unit = "join"
+end
+
+class%java node "test.Node" =
+object
+	val [@java.local] next : node = "next"
+	method [@java.local] get_next : node = "getNext"
+	method [@static] [@java.local] head : node = "head"
+end
+
+class%java [@java.eager] point "test.Point" =
+object
+	val x : int = "x"
+	method [@static] zero : int = "zero"
+end
+
+class%java [@java.eager] label "test.Label" =
+object
+	val [@static] mutable name : string [@java.interned] = "name"
+end
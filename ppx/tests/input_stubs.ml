@@ -0,0 +1,9 @@
+class%java [@java.stubs] counter "test.Counter" =
+object
+	initializer (create : int -> _)
+	val [@static] mutable total : long = "total"
+	val label : string = "label"
+	method add : int -> int = "add"
+	method [@static] name : string = "name"
+	method [@java.blocking] await : unit = "await"
+end
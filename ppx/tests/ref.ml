@@ -152,19 +152,18 @@ module Test :
       let cls = Array.unsafe_get __cls 0 in
       Jcall.write_field_static_int cls id v
     let a obj x0 =
-      Jcall.push_object x0;
-      (let id =
-         let id = Array.unsafe_get __cls 11 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth (__class ()) "a"
-               ("(L" ^
-                  ((A.__class_name ()) ^
-                     (";)L" ^ ((A.__class_name ()) ^ ";")))) in
-           (Array.unsafe_set __cls 11 (Obj.magic id); id)
-         else Obj.magic id in
-       Jcall.call_object obj id)
+      let id =
+        let id = Array.unsafe_get __cls 11 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_meth (__class ()) "a"
+              ("(L" ^
+                 ((A.__class_name ()) ^
+                    (";)L" ^ ((A.__class_name ()) ^ ";")))) in
+          (Array.unsafe_set __cls 11 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.call_object_o obj id x0
     let b obj =
       let id =
         let id = Array.unsafe_get __cls 10 in
@@ -175,6 +174,15 @@ module Test :
         else Obj.magic id in
       Jcall.call_void obj id
     let c obj x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 x10 x11 x12 =
+      let id =
+        let id = Array.unsafe_get __cls 9 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_meth (__class ()) "c"
+              "(IZBSIJCFDLjava/lang/String;Ljava/lang/String;Ljuloo/javacaml/Value;Ljuloo/javacaml/Value;)V" in
+          (Array.unsafe_set __cls 9 (Obj.magic id); id)
+        else Obj.magic id in
       Jcall.push_int x0;
       Jcall.push_bool x1;
       Jcall.push_byte x2;
@@ -188,90 +196,74 @@ module Test :
       Jcall.push_string_opt x10;
       Jcall.push_value x11;
       Jcall.push_value_opt x12;
-      (let id =
-         let id = Array.unsafe_get __cls 9 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth (__class ()) "c"
-               "(IZBSIJCFDLjava/lang/String;Ljava/lang/String;Ljuloo/javacaml/Value;Ljuloo/javacaml/Value;)V" in
-           (Array.unsafe_set __cls 9 (Obj.magic id); id)
-         else Obj.magic id in
-       Jcall.call_void obj id)
+      Jcall.call_void obj id
     let d obj x0 =
-      Jcall.push_object x0;
-      (let id =
-         let id = Array.unsafe_get __cls 8 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth (__class ()) "d" "(Ltest/Test;)Ltest/Test;" in
-           (Array.unsafe_set __cls 8 (Obj.magic id); id)
-         else Obj.magic id in
-       Jcall.call_object obj id)
+      let id =
+        let id = Array.unsafe_get __cls 8 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth (__class ()) "d" "(Ltest/Test;)Ltest/Test;" in
+          (Array.unsafe_set __cls 8 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.call_object_o obj id x0
     let f x0 =
-      Jcall.push_object x0;
-      (let id =
-         let id = Array.unsafe_get __cls 7 in
-         if id == (Obj.magic 0)
-         then
-           let id = Jclass.get_meth_static (__class ()) "f" "(Ltest/Test;)V" in
-           (Array.unsafe_set __cls 7 (Obj.magic id); id)
-         else Obj.magic id in
-       let cls = Array.unsafe_get __cls 0 in Jcall.call_static_void cls id)
+      let id =
+        let id = Array.unsafe_get __cls 7 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth_static (__class ()) "f" "(Ltest/Test;)V" in
+          (Array.unsafe_set __cls 7 (Obj.magic id); id)
+        else Obj.magic id in
+      let cls = Array.unsafe_get __cls 0 in Jcall.call_static_void_o cls id x0
     let g x0 x1 =
-      Jcall.push_object x0;
-      Jcall.push_object x1;
-      (let id =
-         let id = Array.unsafe_get __cls 6 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth_static (__class ()) "g"
-               ("(L" ^
-                  ((Abc.Def.__class_name ()) ^
-                     (";L" ^
-                        ((Ghi.Jkl.Mno.__class_name ()) ^
-                           (";)L" ^ ((Pqr.__class_name ()) ^ ";")))))) in
-           (Array.unsafe_set __cls 6 (Obj.magic id); id)
-         else Obj.magic id in
-       let cls = Array.unsafe_get __cls 0 in Jcall.call_static_object cls id)
+      let id =
+        let id = Array.unsafe_get __cls 6 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_meth_static (__class ()) "g"
+              ("(L" ^
+                 ((Abc.Def.__class_name ()) ^
+                    (";L" ^
+                       ((Ghi.Jkl.Mno.__class_name ()) ^
+                          (";)L" ^ ((Pqr.__class_name ()) ^ ";")))))) in
+          (Array.unsafe_set __cls 6 (Obj.magic id); id)
+        else Obj.magic id in
+      let cls = Array.unsafe_get __cls 0 in
+      Jcall.call_static_object_oo cls id x0 x1
     let h obj x0 x1 =
-      Jcall.push_array x0;
-      Jcall.push_array_opt x1;
-      (let id =
-         let id = Array.unsafe_get __cls 5 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth (__class ()) "h" "([I[[I)[Ljava/lang/Object;" in
-           (Array.unsafe_set __cls 5 (Obj.magic id); id)
-         else Obj.magic id in
-       Jcall.call_array obj id)
+      let id =
+        let id = Array.unsafe_get __cls 5 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_meth (__class ()) "h" "([I[[I)[Ljava/lang/Object;" in
+          (Array.unsafe_set __cls 5 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.push_array x0; Jcall.push_array_opt x1; Jcall.call_array obj id
     let i obj x0 x1 x2 =
+      let id =
+        let id = Array.unsafe_get __cls 4 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_meth (__class ()) "i"
+              "([[[[Ljuloo/javacaml/Value;[B[S)[[D" in
+          (Array.unsafe_set __cls 4 (Obj.magic id); id)
+        else Obj.magic id in
       Jcall.push_array_opt x0;
       Jcall.push_array x1;
       Jcall.push_array_opt x2;
-      (let id =
-         let id = Array.unsafe_get __cls 4 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth (__class ()) "i"
-               "([[[[Ljuloo/javacaml/Value;[B[S)[[D" in
-           (Array.unsafe_set __cls 4 (Obj.magic id); id)
-         else Obj.magic id in
-       Jcall.call_array obj id)
+      Jcall.call_array obj id
     let j obj x0 =
-      Jcall.push_object x0;
-      (let id =
-         let id = Array.unsafe_get __cls 3 in
-         if id == (Obj.magic 0)
-         then
-           let id = Jclass.get_meth (__class ()) "j" "(Ljava/lang/Object;)I" in
-           (Array.unsafe_set __cls 3 (Obj.magic id); id)
-         else Obj.magic id in
-       Jcall.call_int obj id)
+      let id =
+        let id = Array.unsafe_get __cls 3 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth (__class ()) "j" "(Ljava/lang/Object;)I" in
+          (Array.unsafe_set __cls 3 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.call_int_o obj id x0
     let create_default () =
       let id =
         let id = Array.unsafe_get __cls 2 in
@@ -282,19 +274,20 @@ module Test :
         else Obj.magic id in
       let cls = Array.unsafe_get __cls 0 in Jcall.new_ cls id
     let create x0 x1 x2 =
+      let id =
+        let id = Array.unsafe_get __cls 1 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_constructor (__class ())
+              ("(L" ^ ((A.__class_name ()) ^ ";Ljuloo/javacaml/Value;I)V")) in
+          (Array.unsafe_set __cls 1 (Obj.magic id); id)
+        else Obj.magic id in
+      let cls = Array.unsafe_get __cls 0 in
       Jcall.push_object x0;
       Jcall.push_value x1;
       Jcall.push_int x2;
-      (let id =
-         let id = Array.unsafe_get __cls 1 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_constructor (__class ())
-               ("(L" ^ ((A.__class_name ()) ^ ";Ljuloo/javacaml/Value;I)V")) in
-           (Array.unsafe_set __cls 1 (Obj.magic id); id)
-         else Obj.magic id in
-       let cls = Array.unsafe_get __cls 0 in Jcall.new_ cls id)
+      Jcall.new_ cls id
   end 
 module rec
   String_builder:sig
@@ -377,17 +370,17 @@ module rec
       then of_obj_unsafe obj
       else failwith "of_obj"
     let of_builder x0 =
-      Jcall.push_object x0;
-      (let id =
-         let id = Array.unsafe_get __cls 2 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_constructor (__class ())
-               "(Ljava/lang/StringBuilder;)V" in
-           (Array.unsafe_set __cls 2 (Obj.magic id); id)
-         else Obj.magic id in
-       let cls = Array.unsafe_get __cls 0 in Jcall.new_ cls id)
+      let id =
+        let id = Array.unsafe_get __cls 2 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_constructor (__class ())
+              "(Ljava/lang/StringBuilder;)V" in
+          (Array.unsafe_set __cls 2 (Obj.magic id); id)
+        else Obj.magic id in
+      let cls = Array.unsafe_get __cls 0 in
+      Jcall.push_object x0; Jcall.new_ cls id
     let to_string obj =
       let id =
         let id = Array.unsafe_get __cls 1 in
@@ -439,15 +432,192 @@ module Jfloat :
         else Obj.magic id in
       Jcall.call_float obj id
     let of_string x0 =
-      Jcall.push_object x0;
-      (let id =
-         let id = Array.unsafe_get __cls 1 in
-         if id == (Obj.magic 0)
-         then
-           let id =
-             Jclass.get_meth_static (__class ()) "valueOf"
-               ("(L" ^ ((Jstring.__class_name ()) ^ ";)Ljava/lang/Float;")) in
-           (Array.unsafe_set __cls 1 (Obj.magic id); id)
-         else Obj.magic id in
-       let cls = Array.unsafe_get __cls 0 in Jcall.call_static_object cls id)
+      let id =
+        let id = Array.unsafe_get __cls 1 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_meth_static (__class ()) "valueOf"
+              ("(L" ^ ((Jstring.__class_name ()) ^ ";)Ljava/lang/Float;")) in
+          (Array.unsafe_set __cls 1 (Obj.magic id); id)
+        else Obj.magic id in
+      let cls = Array.unsafe_get __cls 0 in
+      Jcall.call_static_object_o cls id x0
+  end 
+module Thread :
+  sig
+    type c = [ `java_lang_Thread ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    val __class_name : unit -> string
+    val __class : unit -> Java.jclass
+    val of_obj : 'a Java.obj -> t
+    val join : _ t' -> unit
+    val join_millis : _ t' -> Int64.t -> unit
+  end =
+  struct
+    type c = [ `java_lang_Thread ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    let __class_name () = "java/lang/Thread"
+    let __cls : Jclass.t array =
+      [|(Obj.magic 0);(Obj.magic 0);(Obj.magic 0)|]
+    let __class () =
+      let cls = Array.unsafe_get __cls 0 in
+      if cls == (Obj.magic 0)
+      then
+        let cls = Jclass.find_class "java/lang/Thread" in
+        (Array.unsafe_set __cls 0 cls; cls)
+      else cls
+    external of_obj_unsafe : 'a Java.obj -> t = "%identity"
+    let of_obj obj =
+      if Java.instanceof obj (__class ())
+      then of_obj_unsafe obj
+      else failwith "of_obj"
+    let join obj =
+      let id =
+        let id = Array.unsafe_get __cls 2 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth (__class ()) "join" "()V" in
+          (Array.unsafe_set __cls 2 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.call_blocking_void obj id
+    let join_millis obj x0 =
+      let id =
+        let id = Array.unsafe_get __cls 1 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth (__class ()) "join" "(J)V" in
+          (Array.unsafe_set __cls 1 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.push_long x0; Jcall.call_blocking_void obj id
+  end 
+module Node :
+  sig
+    type c = [ `test_Node ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    val __class_name : unit -> string
+    val __class : unit -> Java.jclass
+    val of_obj : 'a Java.obj -> t
+    val get'next : _ t' -> t
+    val get_next : _ t' -> t
+    val head : unit -> t
+  end =
+  struct
+    type c = [ `test_Node ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    let __class_name () = "test/Node"
+    let __cls : Jclass.t array =
+      [|(Obj.magic 0);(Obj.magic 0);(Obj.magic 0);(Obj.magic 0)|]
+    let __class () =
+      let cls = Array.unsafe_get __cls 0 in
+      if cls == (Obj.magic 0)
+      then
+        let cls = Jclass.find_class "test/Node" in
+        (Array.unsafe_set __cls 0 cls; cls)
+      else cls
+    external of_obj_unsafe : 'a Java.obj -> t = "%identity"
+    let of_obj obj =
+      if Java.instanceof obj (__class ())
+      then of_obj_unsafe obj
+      else failwith "of_obj"
+    let get'next obj =
+      let id =
+        let id = Array.unsafe_get __cls 3 in
+        if id == (Obj.magic 0)
+        then
+          let id =
+            Jclass.get_field (__class ()) "next"
+              ("L" ^ ("test/Node" ^ ";")) in
+          (Array.unsafe_set __cls 3 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.read_field_object_local obj id
+    let get_next obj =
+      let id =
+        let id = Array.unsafe_get __cls 2 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth (__class ()) "getNext" "()Ltest/Node;" in
+          (Array.unsafe_set __cls 2 (Obj.magic id); id)
+        else Obj.magic id in
+      Jcall.call_object_local obj id
+    let head () =
+      let id =
+        let id = Array.unsafe_get __cls 1 in
+        if id == (Obj.magic 0)
+        then
+          let id = Jclass.get_meth_static (__class ()) "head" "()Ltest/Node;" in
+          (Array.unsafe_set __cls 1 (Obj.magic id); id)
+        else Obj.magic id in
+      let cls = Array.unsafe_get __cls 0 in
+      Jcall.call_static_object_local cls id
+  end 
+module Point :
+  sig
+    type c = [ `test_Point ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    val __class_name : unit -> string
+    val __class : unit -> Java.jclass
+    val of_obj : 'a Java.obj -> t
+    val get'x : _ t' -> int
+    val zero : unit -> int
+  end =
+  struct
+    type c = [ `test_Point ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    let __class_name () = "test/Point"
+    let __cls : Jclass.t array =
+      Jclass.resolve_all "test/Point"
+        [|(Jclass.Meth_static ("zero", "()I"));(Jclass.Field ("x", "I"))|]
+    let __class () = Array.unsafe_get __cls 0
+    external of_obj_unsafe : 'a Java.obj -> t = "%identity"
+    let of_obj obj =
+      if Java.instanceof obj (__class ())
+      then of_obj_unsafe obj
+      else failwith "of_obj"
+    let get'x obj =
+      let id = Obj.magic (Array.unsafe_get __cls 2) in
+      Jcall.read_field_int obj id
+    let zero () =
+      let id = Obj.magic (Array.unsafe_get __cls 1) in
+      let cls = Array.unsafe_get __cls 0 in Jcall.call_static_int cls id
+  end 
+module Label :
+  sig
+    type c = [ `test_Label ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    val __class_name : unit -> string
+    val __class : unit -> Java.jclass
+    val of_obj : 'a Java.obj -> t
+    val get'name : unit -> string
+    val set'name : string -> unit
+  end =
+  struct
+    type c = [ `test_Label ]
+    type 'a t' = ([> c] as 'a) Java.obj
+    type t = c Java.obj
+    let __class_name () = "test/Label"
+    let __cls : Jclass.t array =
+      Jclass.resolve_all "test/Label"
+        [|(Jclass.Field_static ("name", "Ljava/lang/String;"))|]
+    let __class () = Array.unsafe_get __cls 0
+    external of_obj_unsafe : 'a Java.obj -> t = "%identity"
+    let of_obj obj =
+      if Java.instanceof obj (__class ())
+      then of_obj_unsafe obj
+      else failwith "of_obj"
+    let get'name () =
+      let id = Obj.magic (Array.unsafe_get __cls 1) in
+      let cls = Array.unsafe_get __cls 0 in
+      Jcall.read_field_static_string_interned cls id
+    let set'name v =
+      let id = Obj.magic (Array.unsafe_get __cls 1) in
+      let cls = Array.unsafe_get __cls 0 in
+      Jcall.write_field_static_string_interned cls id v
   end 
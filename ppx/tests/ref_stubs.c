@@ -0,0 +1,126 @@
+/* Generated by ocamljava-ppx */
+
+#include <ocamljava_stubs.h>
+
+/*
+** test/Counter
+*/
+
+static jclass ocamljava_stub_test_Counter__class;
+static jmethodID ocamljava_stub_test_Counter__create__id;
+static jfieldID ocamljava_stub_test_Counter__field_total;
+static jfieldID ocamljava_stub_test_Counter__field_label;
+static jmethodID ocamljava_stub_test_Counter__add__id;
+static jmethodID ocamljava_stub_test_Counter__name__id;
+
+value ocamljava_stub_test_Counter__create(intnat x0)
+{
+	JNIEnv *const	env = ocaml_java__env();
+	int const		mark = ocaml_java__stub_enter();
+	jvalue			args[1];
+	jobject			res;
+
+	args[0].i = (jint)x0;
+	res = (*env)->NewObjectA(env, ocamljava_stub_test_Counter__class, ocamljava_stub_test_Counter__create__id, args);
+	ocaml_java__stub_leave(mark);
+	return ocaml_java__stub_of_obj(env, res);
+}
+
+value ocamljava_stub_test_Counter__create_byte(value x0)
+{
+	return ocamljava_stub_test_Counter__create(Long_val(x0));
+}
+
+int64_t ocamljava_stub_test_Counter__get_total(value unit)
+{
+	JNIEnv *const	env = ocaml_java__env_noraise();
+	jlong const	res = (*env)->GetStaticLongField(env, ocamljava_stub_test_Counter__class, ocamljava_stub_test_Counter__field_total);
+
+	return (int64_t)res;
+}
+
+value ocamljava_stub_test_Counter__get_total_byte(value unit)
+{
+	return caml_copy_int64(ocamljava_stub_test_Counter__get_total(unit));
+}
+
+value ocamljava_stub_test_Counter__set_total(int64_t v)
+{
+	JNIEnv *const	env = ocaml_java__env_noraise();
+
+	(*env)->SetStaticLongField(env, ocamljava_stub_test_Counter__class, ocamljava_stub_test_Counter__field_total, (jlong)v);
+	return Val_unit;
+}
+
+value ocamljava_stub_test_Counter__set_total_byte(value v)
+{
+	return ocamljava_stub_test_Counter__set_total(Int64_val(v));
+}
+
+value ocamljava_stub_test_Counter__get_label(value obj)
+{
+	JNIEnv *const	env = ocaml_java__env();
+	int const		mark = ocaml_java__stub_enter();
+	jobject			res;
+
+	if (obj == Val_long(0))
+		ocaml_java__stub_null();
+	res = (*env)->GetObjectField(env, ocaml_java__stub_obj(env, obj, mark), ocamljava_stub_test_Counter__field_label);
+	ocaml_java__stub_leave(mark);
+	return ocaml_java__stub_of_string(env, res);
+}
+
+value ocamljava_stub_test_Counter__get_label_byte(value obj)
+{
+	return ocamljava_stub_test_Counter__get_label(obj);
+}
+
+intnat ocamljava_stub_test_Counter__add(value obj, intnat x0)
+{
+	JNIEnv *const	env = ocaml_java__env();
+	int const		mark = ocaml_java__stub_enter();
+	jvalue			args[1];
+	jint			res;
+
+	if (obj == Val_long(0))
+		ocaml_java__stub_null();
+	args[0].i = (jint)x0;
+	res = (*env)->CallIntMethodA(env, ocaml_java__stub_obj(env, obj, mark), ocamljava_stub_test_Counter__add__id, args);
+	ocaml_java__stub_leave(mark);
+	return (intnat)res;
+}
+
+value ocamljava_stub_test_Counter__add_byte(value obj, value x0)
+{
+	return Val_long(ocamljava_stub_test_Counter__add(obj, Long_val(x0)));
+}
+
+value ocamljava_stub_test_Counter__name(value unit)
+{
+	JNIEnv *const	env = ocaml_java__env();
+	int const		mark = ocaml_java__stub_enter();
+	jobject			res;
+
+	res = (*env)->CallStaticObjectMethodA(env, ocamljava_stub_test_Counter__class, ocamljava_stub_test_Counter__name__id, NULL);
+	ocaml_java__stub_leave(mark);
+	return ocaml_java__stub_of_string(env, res);
+}
+
+value ocamljava_stub_test_Counter__name_byte(value unit)
+{
+	return ocamljava_stub_test_Counter__name(unit);
+}
+
+value ocamljava_stub_test_Counter__init(value unit)
+{
+	JNIEnv *const	env = ocaml_java__env();
+
+	ocamljava_stub_test_Counter__class = ocaml_java__stub_class(env, "test/Counter");
+	ocamljava_stub_test_Counter__create__id = ocaml_java__stub_method(env, ocamljava_stub_test_Counter__class, "<init>", "(I)V", 0);
+	ocamljava_stub_test_Counter__field_total = ocaml_java__stub_field(env, ocamljava_stub_test_Counter__class, "total", "J", 1);
+	ocamljava_stub_test_Counter__field_label = ocaml_java__stub_field(env, ocamljava_stub_test_Counter__class, "label", "Ljava/lang/String;", 0);
+	ocamljava_stub_test_Counter__add__id = ocaml_java__stub_method(env, ocamljava_stub_test_Counter__class, "add", "(I)I", 0);
+	ocamljava_stub_test_Counter__name__id = ocaml_java__stub_method(env, ocamljava_stub_test_Counter__class, "name", "()Ljava/lang/String;", 1);
+	return Val_unit;
+	(void)unit;
+}
@@ -4,34 +4,70 @@ open Ast_tools
 (** Represent a type that have convertions in ocaml-java
 	Most expressions expect "obj", "id" and/or "cls" to be defined to
 	the current object, the ID of the method/field and the current class
-	`push` takes the name of the argument as parameter *)
+	`push` takes the name of the argument as parameter
+	`fused_arg` is the argument code and the converted argument
+		and `fused_ret` the suffix and the convertion of the result
+		for the fused externals (eg. `Jcall.call_int_io`)
+	`local` is the same type returned as a local object
+		(eg. `Jcall.call_object_local`), for object types only
+	`stub` is the suffix of the Jcall functions (eg. "int")
+		if the type has no convertion on the OCaml side,
+		it is used to generate C stubs (see `Stubs`) *)
 type t = {
 	sigt : expression;
 	type_ : core_type;
 	push : string -> expression;
 	call : expression;
 	call_static : expression;
+	call_blocking : expression;
+	call_static_blocking : expression;
 	read_field : expression;
 	write_field : expression;
 	read_field_static : expression;
-	write_field_static : expression
+	write_field_static : expression;
+	fused_arg : (string * (string -> expression)) option;
+	fused_ret : (string * (expression -> expression)) option;
+	local : t option;
+	stub : string option
 }
 
 (** Create a type_info
 	`conv_to`/`conv_of` are applied to the argument/return value
 		of call, read and write calls *)
-let create ~push ~call ~call_static ~read_field ~write_field
-	~read_field_static ~write_field_static sigt type_ conv_to conv_of =
-	let push arg = [%expr [%e push] ([%e conv_to (mk_ident [ arg ])])] in
-	{ sigt; type_; push;
+let create ~push ~call ~call_static ~call_blocking ~call_static_blocking
+	~read_field ~write_field ~read_field_static ~write_field_static
+	~fused_arg ~fused_ret ?local ?stub sigt type_ conv_to conv_of =
+	let push arg = [%expr [%e push] ([%e conv_to (mk_ident [ arg ])])]
+	and fused_arg = match fused_arg with
+		| Some code	-> Some (code, fun arg -> conv_to (mk_ident [ arg ]))
+		| None		-> None
+	and fused_ret = match fused_ret with
+		| Some suffix	-> Some (suffix, conv_of)
+		| None			-> None
+	in
+	{ sigt; type_; push; fused_arg; fused_ret; local; stub;
 		call = conv_of [%expr [%e call] obj id];
 		call_static = conv_of [%expr [%e call_static] cls id];
+		call_blocking = conv_of [%expr [%e call_blocking] obj id];
+		call_static_blocking =
+			conv_of [%expr [%e call_static_blocking] cls id];
 		read_field = conv_of [%expr [%e read_field] obj id];
 		write_field = [%expr [%e write_field] obj id [%e conv_to [%expr v]]];
 		read_field_static = conv_of [%expr [%e read_field_static] cls id];
 		write_field_static =
 			[%expr [%e write_field_static] cls id [%e conv_to [%expr v]]] }
 
+(** Returns the type_info `ti` with the results converted to local objects
+	Raises a location error at `loc` if the type cannot be local *)
+let to_local ~loc ti =
+	match ti.local with
+	| Some l	->
+		{ ti with call = l.call; call_static = l.call_static;
+			read_field = l.read_field; read_field_static = l.read_field_static;
+			fused_ret = None; stub = None }
+	| None		->
+		Location.raise_errorf ~loc "Only objects can be local"
+
 (** Concat a list of type_info by signatures *)
 let rec concat_sigt =
 	function
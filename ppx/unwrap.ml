@@ -15,20 +15,25 @@ let rec method_type =
 		lhs :: args, ret
 	| t									-> [], t
 
+(** Returns `true` if the attribute `name`, without payload, is in the list *)
+let rec has_attr name =
+	function
+	| ({ txt; _ }, PStr []) :: _ when txt = name -> true
+	| []		-> false
+	| _ :: tl	-> has_attr name tl
+
 (** Unwrap a class field
 	Returns one of
-		`Method (name, java_name, method_type)
-		`Method_static ..
-		`Field (name, java_name, core_type)
-		`Field_static ..
+		`Method (name, java_name, method_type, static, blocking, local)
+		`Field (name, java_name, core_type, mutable, static, local)
 		`Constructor (name, args core_type list)
 	Raises a location error on syntax errors *)
 let class_field =
-	let rec is_static =
-		function
-		| ({ txt = "static"; _ }, PStr []) :: _ -> true
-		| []		-> false
-		| _ :: tl	-> is_static tl
+	let is_static = has_attr "static"
+	and is_blocking attrs =
+		has_attr "java.blocking" attrs || has_attr "blocking" attrs
+	and is_local attrs =
+		has_attr "java.local" attrs || has_attr "local" attrs
 	in
 
 	function
@@ -40,8 +45,12 @@ let class_field =
 		| Cfk_concrete (Fresh, { pexp_desc = Pexp_poly (
 				{ pexp_desc = Pexp_constant (Pconst_string (jname, None)); _ },
 				Some mtype); _ })	->
-			let static = is_static pcf_attributes in
-			`Method (name, jname, method_type mtype, static)
+			let static = is_static pcf_attributes
+			and blocking = is_blocking pcf_attributes
+			and local = is_local pcf_attributes in
+			if blocking && local then
+				Location.raise_errorf ~loc "Blocking methods cannot be local";
+			`Method (name, jname, method_type mtype, static, blocking, local)
 		| Cfk_concrete (Fresh, { pexp_desc = Pexp_poly (
 				{ pexp_loc = loc; _ }, _); _ })	->
 			Location.raise_errorf ~loc "Expecting Java method name"
@@ -60,8 +69,9 @@ let class_field =
 		| Cfk_concrete (Fresh, { pexp_desc = Pexp_constraint (
 				{ pexp_desc = Pexp_constant (Pconst_string (jname, None)); _ },
 				ftype ); _ })		->
-			let static = is_static pcf_attributes in
-			`Field (name, jname, ftype, mut = Mutable, static)
+			let static = is_static pcf_attributes
+			and local = is_local pcf_attributes in
+			`Field (name, jname, ftype, mut = Mutable, static, local)
 		| Cfk_concrete (Fresh, { pexp_desc = Pexp_constraint (
 				{ pexp_loc = loc; _ }, _ ); _ })	->
 			Location.raise_errorf ~loc "Expecting Java field name"
@@ -100,11 +110,17 @@ let class_field =
 	| { pcf_loc = loc; _ } -> Location.raise_errorf ~loc "Unsupported"
 
 (** Unwrap the class_info node
-	Returns the tuple (class_name, java_path, class_field list)
+	Returns the tuple
+		(class_name, java_path, supers, class_field list, eager, stubs)
 	Raises a location error on syntax errors *)
 let class_ =
+	let is_eager attrs =
+		has_attr "java.eager" attrs || has_attr "eager" attrs
+	and is_stubs attrs =
+		has_attr "java.stubs" attrs || has_attr "stubs" attrs
+	in
 	function
-	| {	pci_name = { txt = class_name; _ };
+	| {	pci_name = { txt = class_name; _ }; pci_attributes;
 		pci_expr = { pcl_desc = Pcl_fun (Nolabel, None,
 				{ ppat_desc = Ppat_constant (Pconst_string (java_path, None)); _ },
 				{ pcl_desc = Pcl_structure {
@@ -116,7 +132,8 @@ let class_ =
 			| (`Method _ | `Field _ | `Constructor _) as f' ->
 				s, (f', field.pcf_loc) :: f
 		) fields ([], []) in
-		class_name, java_path, supers, fields
+		class_name, java_path, supers, fields, is_eager pci_attributes,
+		is_stubs pci_attributes
 	| { pci_expr = { pcl_desc = Pcl_fun (_, _, _, { pcl_desc = Pcl_structure {
         pcstr_self = { ppat_desc; ppat_loc = loc; _ }; _
     }; _}); _}; _ } when ppat_desc <> Ppat_any ->
@@ -6,6 +6,15 @@ let () =
 	| exception Not_found ->
 		failwith "Environment variable JAVA_HOME is not set."
 	| java_home ->
-		w "c_flags.sexp" "(-I \"%s/include\" -I \"%s/include/linux\")" java_home java_home;
+		(* Set OCAMLJAVA_HANDLE_TABLE to store Java.obj in a handle table
+			instead of using a global ref for each object *)
+		let defines =
+			match Sys.getenv "OCAMLJAVA_HANDLE_TABLE" with
+			| exception Not_found -> ""
+			| "" | "0" -> ""
+			| _ -> " -DOCAMLJAVA_HANDLE_TABLE"
+		in
+		w "c_flags.sexp" "(-I \"%s/include\" -I \"%s/include/linux\"%s)"
+			java_home java_home defines;
 		let lpath = java_home ^ "/jre/lib/amd64/server" in
 		w "c_library_flags.sexp" "(-dllpath \"%s/libjvm.so\" \"-L%s\")" lpath lpath
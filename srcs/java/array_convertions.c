@@ -0,0 +1,342 @@
+#include "javacaml_utils.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+/*
+** ========================================================================== **
+** Convertion between OCaml arrays and Java primitive arrays
+** -
+** `ocaml_java__untag_*` converts tagged OCaml ints to a Java type,
+** 		the values are truncated like a C cast
+** `ocaml_java__tag_*` converts to tagged OCaml ints,
+** 		the destination must contain immediate values (no write barrier)
+** `ocaml_java__untag_*_checked` does not truncate, returns the index
+** 		of the first value that does not fit (`n` if all fit)
+** 		the elements of `dst` after this index are unspecified
+** `ocaml_java__from_double_*`/`ocaml_java__to_double_*` convert from/to
+** 		the content of OCaml float arrays
+** -
+** The main loops use SSE2 if available, the tagged versions assume
+** 		64 bits values
+*/
+
+#if defined(__SSE2__) && defined(ARCH_SIXTYFOUR)
+# define SIMD_TAG
+#endif
+
+#ifdef SIMD_TAG
+
+// Untag 2 values, the result is a 64 bits arithmetic shift
+static inline __m128i	untag2(value const *src)
+{
+	__m128i const	v = _mm_loadu_si128((__m128i const*)src);
+
+	return _mm_or_si128(_mm_srli_epi64(v, 1),
+			_mm_and_si128(v, _mm_set1_epi64x(INT64_MIN)));
+}
+
+// Untag 4 values, keeps the low 32 bits of each
+static inline __m128i	untag4(value const *src)
+{
+	__m128i const	a = _mm_srli_epi64(
+				_mm_loadu_si128((__m128i const*)src), 1);
+	__m128i const	b = _mm_srli_epi64(
+				_mm_loadu_si128((__m128i const*)(src + 2)), 1);
+
+	return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a),
+				_mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// Untag 8 values, keeps the low 16 bits of each
+// The values are sign-extended first so `packs` does not saturate
+static inline __m128i	untag8(value const *src)
+{
+	__m128i const	a = _mm_srai_epi32(_mm_slli_epi32(untag4(src), 16), 16);
+	__m128i const	b =
+		_mm_srai_epi32(_mm_slli_epi32(untag4(src + 4), 16), 16);
+
+	return _mm_packs_epi32(a, b);
+}
+
+// Untag 16 values, keeps the low 8 bits of each
+static inline __m128i	untag16(value const *src)
+{
+	__m128i const	a = _mm_srai_epi16(_mm_slli_epi16(untag8(src), 8), 8);
+	__m128i const	b =
+		_mm_srai_epi16(_mm_slli_epi16(untag8(src + 8), 8), 8);
+
+	return _mm_packs_epi16(a, b);
+}
+
+// Tag 2 64 bits ints
+static inline void		tag2(value *dst, __m128i v)
+{
+	_mm_storeu_si128((__m128i*)dst,
+		_mm_or_si128(_mm_slli_epi64(v, 1), _mm_set1_epi64x(1)));
+}
+
+// Tag 4 32 bits ints, `ext` contains the high bits of each
+static inline void		tag4(value *dst, __m128i v, __m128i ext)
+{
+	tag2(dst, _mm_unpacklo_epi32(v, ext));
+	tag2(dst + 2, _mm_unpackhi_epi32(v, ext));
+}
+
+// Tag 8 16 bits ints, `ext` contains the high bits of each
+static inline void		tag8(value *dst, __m128i v, __m128i ext)
+{
+	__m128i const	lo = _mm_unpacklo_epi16(v, ext);
+	__m128i const	hi = _mm_unpackhi_epi16(v, ext);
+
+	tag4(dst, lo, _mm_srai_epi32(lo, 31));
+	tag4(dst + 4, hi, _mm_srai_epi32(hi, 31));
+}
+
+// Tag 16 signed bytes
+static inline void		tag16(value *dst, __m128i v)
+{
+	__m128i const	ext = _mm_cmpgt_epi8(_mm_setzero_si128(), v);
+	__m128i const	lo = _mm_unpacklo_epi8(v, ext);
+	__m128i const	hi = _mm_unpackhi_epi8(v, ext);
+
+	tag8(dst, lo, _mm_srai_epi16(lo, 15));
+	tag8(dst + 8, hi, _mm_srai_epi16(hi, 15));
+}
+
+#endif
+
+/*
+** Tagged ints to Java
+*/
+
+void	ocaml_java__untag_jint(value const *src, jint *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 4 <= n; i += 4)
+		_mm_storeu_si128((__m128i*)(dst + i), untag4(src + i));
+#endif
+	for (; i < n; i++)
+		dst[i] = Long_val(src[i]);
+}
+
+void	ocaml_java__untag_jlong(value const *src, jlong *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 2 <= n; i += 2)
+		_mm_storeu_si128((__m128i*)(dst + i), untag2(src + i));
+#endif
+	for (; i < n; i++)
+		dst[i] = Long_val(src[i]);
+}
+
+void	ocaml_java__untag_jshort(value const *src, jshort *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 8 <= n; i += 8)
+		_mm_storeu_si128((__m128i*)(dst + i), untag8(src + i));
+#endif
+	for (; i < n; i++)
+		dst[i] = Long_val(src[i]);
+}
+
+void	ocaml_java__untag_jchar(value const *src, jchar *dst, size_t n)
+{
+	ocaml_java__untag_jshort(src, (jshort*)dst, n);
+}
+
+void	ocaml_java__untag_jbyte(value const *src, jbyte *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 16 <= n; i += 16)
+		_mm_storeu_si128((__m128i*)(dst + i), untag16(src + i));
+#endif
+	for (; i < n; i++)
+		dst[i] = Long_val(src[i]);
+}
+
+void	ocaml_java__untag_jboolean(value const *src, jboolean *dst, size_t n)
+{
+	ocaml_java__untag_jbyte(src, (jbyte*)dst, n);
+}
+
+/*
+** Java to tagged ints
+*/
+
+void	ocaml_java__tag_jint(jint const *src, value *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128i const	v = _mm_loadu_si128((__m128i const*)(src + i));
+
+		tag4(dst + i, v, _mm_srai_epi32(v, 31));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = Val_long(src[i]);
+}
+
+void	ocaml_java__tag_jlong(jlong const *src, value *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 2 <= n; i += 2)
+		tag2(dst + i, _mm_loadu_si128((__m128i const*)(src + i)));
+#endif
+	for (; i < n; i++)
+		dst[i] = Val_long(src[i]);
+}
+
+void	ocaml_java__tag_jshort(jshort const *src, value *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 8 <= n; i += 8)
+	{
+		__m128i const	v = _mm_loadu_si128((__m128i const*)(src + i));
+
+		tag8(dst + i, v, _mm_srai_epi16(v, 15));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = Val_long(src[i]);
+}
+
+void	ocaml_java__tag_jchar(jchar const *src, value *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 8 <= n; i += 8)
+		tag8(dst + i, _mm_loadu_si128((__m128i const*)(src + i)),
+			_mm_setzero_si128());
+#endif
+	for (; i < n; i++)
+		dst[i] = Val_long(src[i]);
+}
+
+void	ocaml_java__tag_jbyte(jbyte const *src, value *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 16 <= n; i += 16)
+		tag16(dst + i, _mm_loadu_si128((__m128i const*)(src + i)));
+#endif
+	for (; i < n; i++)
+		dst[i] = Val_long(src[i]);
+}
+
+// Any non-zero byte is `true`
+void	ocaml_java__tag_jboolean(jboolean const *src, value *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef SIMD_TAG
+	for (; i + 16 <= n; i += 16)
+		tag16(dst + i, _mm_min_epu8(
+				_mm_loadu_si128((__m128i const*)(src + i)),
+				_mm_set1_epi8(1)));
+#endif
+	for (; i < n; i++)
+		dst[i] = Val_bool(src[i]);
+}
+
+/*
+** Checked versions
+** Each block is converted then converted back and compared with the source
+*/
+
+#define CHECK_BLOCK		64
+
+#define GEN_UNTAG_CHECKED(TYPE) \
+size_t	ocaml_java__untag_##TYPE##_checked(value const *src, TYPE *dst,	\
+			size_t n)														\
+{																			\
+	value			tmp[CHECK_BLOCK];										\
+	size_t			i;														\
+	size_t			j;														\
+	size_t			len;													\
+																			\
+	for (i = 0; i < n; i += len)											\
+	{																		\
+		len = (n - i < CHECK_BLOCK) ? n - i : CHECK_BLOCK;					\
+		ocaml_java__untag_##TYPE(src + i, dst + i, len);					\
+		ocaml_java__tag_##TYPE(dst + i, tmp, len);							\
+		if (memcmp(tmp, src + i, len * sizeof(value)) != 0)					\
+		{																	\
+			for (j = 0; tmp[j] == src[i + j]; j++)							\
+				;															\
+			return i + j;													\
+		}																	\
+	}																		\
+	return n;																\
+}
+
+GEN_UNTAG_CHECKED(jint)
+GEN_UNTAG_CHECKED(jshort)
+GEN_UNTAG_CHECKED(jbyte)
+
+/*
+** Float arrays
+*/
+
+void	ocaml_java__from_double_jfloat(double const *src, jfloat *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef __SSE2__
+	for (; i + 4 <= n; i += 4)
+		_mm_storeu_ps(dst + i, _mm_movelh_ps(
+				_mm_cvtpd_ps(_mm_loadu_pd(src + i)),
+				_mm_cvtpd_ps(_mm_loadu_pd(src + i + 2))));
+#endif
+	for (; i < n; i++)
+		dst[i] = src[i];
+}
+
+void	ocaml_java__to_double_jfloat(jfloat const *src, double *dst, size_t n)
+{
+	size_t			i = 0;
+
+#ifdef __SSE2__
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 const	v = _mm_loadu_ps(src + i);
+
+		_mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+		_mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = src[i];
+}
+
+void	ocaml_java__from_double_jdouble(double const *src, jdouble *dst,
+			size_t n)
+{
+	memcpy(dst, src, n * sizeof(jdouble));
+}
+
+void	ocaml_java__to_double_jdouble(jdouble const *src, double *dst, size_t n)
+{
+	memcpy(dst, src, n * sizeof(jdouble));
+}
@@ -4,6 +4,7 @@
 
 #include <jni.h>
 #include <stddef.h>
+#include <unistd.h>
 
 #include <caml/alloc.h>
 #include <caml/callback.h>
@@ -18,9 +19,93 @@
 			"Called with null `" ARG_NAME "`"), \
 		(void)0)
 
+// Throws a ThreadException if the thread is in a blocking call
+//  (see `ocaml_java__in_blocking_call`), it does not hold the runtime lock
+static int check_not_blocking(JNIEnv *env)
+{
+	if (!ocaml_java__in_blocking_call())
+		return 1;
+	(*env)->ThrowNew(env, CLASS(ThreadException),
+		"Calling OCaml code from a blocking call");
+	return 0;
+}
+
 // ========================================================================== //
 // Value
 // juloo.javacaml.Value
+// -
+// A Value points to a cell holding an OCaml value
+// Cells are allocated by slabs of `VALUE_SLAB_SIZE` and never freed,
+//  the free cells are linked through `free_cells`
+// Cells are generational global roots: minor collections only scan
+//  the cells that were set since the previous minor collection
+// -
+// Values are released by batches from the Java side (see Value.java),
+//  always from the thread that holds the runtime lock
+//  `Java.flush_released` releases the last partial batch
+
+#define VALUE_SLAB_SIZE		1024
+
+struct value_cell
+{
+	value				v; // Must be the first field
+	struct value_cell	*next;
+};
+
+static struct value_cell *free_cells = NULL;
+static long live_cells = 0;
+
+static void add_value_slab(void)
+{
+	struct value_cell *const	slab =
+		caml_stat_alloc(sizeof(struct value_cell) * VALUE_SLAB_SIZE);
+	int							i;
+
+	for (i = 0; i < VALUE_SLAB_SIZE; i++)
+	{
+		slab[i].v = Val_unit;
+		slab[i].next = (i + 1 < VALUE_SLAB_SIZE) ? &slab[i + 1] : free_cells;
+	}
+	free_cells = slab;
+}
+
+value *ocaml_java__jvalue_alloc(value v)
+{
+	struct value_cell	*cell;
+
+	if (free_cells == NULL)
+		add_value_slab();
+	cell = free_cells;
+	free_cells = cell->next;
+	cell->v = v;
+	caml_register_generational_global_root(&cell->v);
+	live_cells++;
+	return &cell->v;
+}
+
+void ocaml_java__jvalue_release(value *v)
+{
+	struct value_cell *const	cell = (struct value_cell*)v;
+
+	caml_remove_generational_global_root(&cell->v);
+	cell->v = Val_unit;
+	cell->next = free_cells;
+	free_cells = cell;
+	live_cells--;
+}
+
+// Number of cells in use, for the tests
+value ocaml_java__jvalue_count(value unit)
+{
+	return Val_long(live_cells);
+	(void)unit;
+}
+
+void ocaml_java__jvalue_collect(JNIEnv *env)
+{
+	(*env)->CallStaticVoidMethod(env, CLASS(Value),
+		STATIC_METHOD(Value, collect));
+}
 
 // Return the value pointed to by the Value `v`
 value ocaml_java__jvalue_get(JNIEnv *env, jobject v)
@@ -33,19 +118,38 @@ value ocaml_java__jvalue_get(JNIEnv *env, jobject v)
 // Create a new Value object that point to `v`
 jobject ocaml_java__jvalue_new(JNIEnv *env, value v)
 {
-	value *const global = caml_stat_alloc(sizeof(value));
+	value *const global = ocaml_java__jvalue_alloc(v);
 
-	caml_register_global_root(global);
-	*global = v;
 	return (*env)->NewObject(env, CLASS(Value), CONSTR(Value), (jlong)global);
 }
 
-void Java_juloo_javacaml_Value_release(JNIEnv *env, jobject v)
+void Java_juloo_javacaml_Value_release(JNIEnv *env, jclass c,
+		jlongArray values, jint count)
 {
-	long const v_ = (*env)->GetLongField(env, v, FIELD(Value, value));
-	value *const global = (value*)v_;
+	jlong *const	v = (*env)->GetPrimitiveArrayCritical(env, values, NULL);
+	jint			i;
+
+	for (i = 0; i < count; i++)
+		ocaml_java__jvalue_release((value*)v[i]);
+	(*env)->ReleasePrimitiveArrayCritical(env, values, v, JNI_ABORT);
+	(void)c;
+}
 
-	caml_remove_global_root(global);
+// ========================================================================== //
+// CamlExecutor
+// juloo.javacaml.CamlExecutor
+// -
+// `wake` is called from any thread, it does not use the OCaml runtime
+// The pipe may be full if the OCaml side is late, the byte is not needed then
+
+void Java_juloo_javacaml_CamlExecutor_wake(JNIEnv *env, jclass c, jint fd)
+{
+	char const	b = 0;
+
+	if (write(fd, &b, 1) < 0)
+		return ;
+	(void)env;
+	(void)c;
 }
 
 // ========================================================================== //
@@ -54,23 +158,102 @@ void Java_juloo_javacaml_Value_release(JNIEnv *env, jobject v)
 // A stack is used to store the function and its arguments before calling it.
 // It is represented as an OCaml array
 // -
-// The first element of the stack is the function to call
+// Each call uses a frame, `function` and `method` push a new frame
+// The first element of a frame is the function to call
+// `frames` stores the index of the first element of each frame
+// A call pops its frame, the top frame is the current one
 // -
 // The counter `stack_size` is used to keep track of the top of the stack
-// The stack is emptied after a call.
+// Java can begin a new call before calling the current one (eg. to compute
+//  an argument) or from the function being called
+// -
+// The stack and `frames` are allocated once, see `setCallStackSize`
+
+#define DEFAULT_STACK_SIZE	512
+#define DEFAULT_MAX_DEPTH	64
 
-#define STACK_MAX_SIZE 16
+static value stack = Val_unit;
+static int stack_size = 0;
+static int stack_capacity = 0;
 
-static value stack;
-static int stack_size;
+static int *frames = NULL;
+static int frame_count = 0;
+static int max_depth = 0;
 
-// Fill the stack with Val_unit
-static void empty_stack(void)
+// Replace the stack, must be empty
+static void alloc_stack(int capacity, int depth)
 {
-	int i;
+	int *const	new_frames = caml_stat_alloc(sizeof(int) * depth);
+
+	caml_stat_free(frames);
+	frames = new_frames;
+	max_depth = depth;
+	stack = caml_alloc(capacity, 0);
+	stack_capacity = capacity;
+}
 
-	for (i = 0; i < stack_size; i++)
+// Begin a frame, `f` is the function to call
+// Returns false and throws an exception if the depth limit is reached
+static int push_frame(JNIEnv *env, value f)
+{
+	if (frame_count >= max_depth || stack_size >= stack_capacity)
+	{
+		(*env)->ThrowNew(env, CLASS(ArgumentStackOverflowException),
+				"Call depth limit reached");
+		return 0;
+	}
+	frames[frame_count++] = stack_size;
+	Store_field(stack, stack_size, f);
+	stack_size++;
+	return 1;
+}
+
+// Remove the current frame
+// Fill its slots with Val_unit to release the values
+static void pop_frame(void)
+{
+	int const	base = frames[--frame_count];
+	int			i;
+
+	for (i = base; i < stack_size; i++)
 		Store_field(stack, i, Val_unit);
+	stack_size = base;
+}
+
+// Calls the function of the current frame with its arguments
+// Same as `caml_callbackN_exn` but the stack is accessed through `stack`
+//  because it may be moved by the GC during the callback
+static value call_frame(void)
+{
+	CAMLparam0();
+	CAMLlocal1(res);
+	int const	top = stack_size;
+	int			i;
+
+	i = frames[frame_count - 1];
+	res = Field(stack, i++);
+	while (i < top)
+	{
+		switch (top - i)
+		{
+		case 1:
+			res = caml_callback_exn(res, Field(stack, i));
+			i += 1;
+			break ;
+		case 2:
+			res = caml_callback2_exn(res, Field(stack, i), Field(stack, i + 1));
+			i += 2;
+			break ;
+		default:
+			res = caml_callback3_exn(res, Field(stack, i), Field(stack, i + 1),
+					Field(stack, i + 2));
+			i += 3;
+			break ;
+		}
+		if (Is_exception_result(res))
+			break ;
+	}
+	CAMLreturn(res);
 }
 
 // Alloc an array of StackTraceElement
@@ -103,74 +286,199 @@ static jobjectArray alloc_stack_trace_elements(JNIEnv *env, value locations)
 	return elements;
 }
 
-// Returns an array of tuple (file_name, line_number)
-static value get_ocaml_backtrace()
+// Returns the constructor of an exception
+static value exn_constructor(value exn)
+{
+	return (Tag_val(exn) == 0) ? Field(exn, 0) : exn;
+}
+
+// Returns a new local ref to the object of `v`, that the caller must delete
+// `NULL` if `v` is a local object used outside of its frame
+static jobject obj_new_local_ref(JNIEnv *env, value v)
 {
-	static value	*get_backtrace = NULL;
+	jobject		obj;
 
-	if (get_backtrace == NULL)
+	if (Is_java_local_obj(v))
 	{
-		get_backtrace = caml_named_value("Java.get_ocaml_backtraces");
-		if (get_backtrace == NULL)
-			return Atom(0); // Don't fail, just return an empty array
+		obj = ocaml_java__local_obj_get(v);
+		return (obj == NULL) ? NULL : (*env)->NewLocalRef(env, obj);
 	}
-	return caml_callback(*get_backtrace, Val_unit);
+#ifdef OCAMLJAVA_HANDLE_TABLE
+	return Java_global_obj_val(v);
+#else
+	return (*env)->NewLocalRef(env, Java_global_obj_val(v));
+#endif
 }
 
-static jobject get_cause(value exn)
+// Returns the object of a `Java.Exception`, NULL for other exceptions
+// The result is a new local ref
+static jobject get_cause(JNIEnv *env, value exn)
 {
-	static value	*get_cause;
-	value			cause_opt;
+	static value const	*java_exception = NULL;
 
-	if (get_cause == NULL)
+	if (java_exception == NULL)
 	{
-		get_cause = caml_named_value("Java.get_cause");
-		if (get_cause == NULL)
+		java_exception = caml_named_value("Java.Exception");
+		if (java_exception == NULL)
 			return NULL; // No need to panic
 	}
-	cause_opt = caml_callback(*get_cause, exn);
-	if (cause_opt == Val_none)
+	if (exn_constructor(exn) != *java_exception)
 		return NULL;
-	return Java_obj_val(Some_val(cause_opt));
+	return obj_new_local_ref(env, Field(exn, 1));
+}
+
+// From OCaml's runtime, `Printexc.get_raw_backtrace`
+value caml_get_exception_raw_backtrace(value unit);
+
+/*
+** Stackless exceptions
+** -
+** Exceptions registered with `Java.register_stackless` are thrown
+** 		as a preallocated CamlException (held by a global ref)
+** `stackless_constrs` are generational global roots
+*/
+
+#define MAX_STACKLESS		32
+
+static value	stackless_constrs[MAX_STACKLESS];
+static jobject	stackless_exns[MAX_STACKLESS];
+static int		stackless_count = 0;
+
+static jobject find_stackless(value exn)
+{
+	value const	constr = exn_constructor(exn);
+	int			i;
+
+	for (i = 0; i < stackless_count; i++)
+		if (stackless_constrs[i] == constr)
+			return stackless_exns[i];
+	return NULL;
+}
+
+value ocaml_java__register_stackless(value exn)
+{
+	JNIEnv *const	env = ocaml_java__env();
+	char			*_exn_msg;
+	jstring			exn_msg;
+	jobject			java_exn;
+
+	if (find_stackless(exn) != NULL)
+		return Val_unit;
+	if (stackless_count >= MAX_STACKLESS)
+		caml_failwith("Java.register_stackless: Too many exceptions");
+	_exn_msg = caml_format_exception(exn);
+	exn_msg = (*env)->NewStringUTF(env, _exn_msg);
+	caml_stat_free(_exn_msg);
+	java_exn = (*env)->CallStaticObjectMethod(env, CLASS(CamlException),
+			STATIC_METHOD(CamlException, stackless), exn_msg);
+	(*env)->DeleteLocalRef(env, exn_msg);
+	stackless_exns[stackless_count] = (*env)->NewGlobalRef(env, java_exn);
+	(*env)->DeleteLocalRef(env, java_exn);
+	stackless_constrs[stackless_count] = exn_constructor(exn);
+	caml_register_generational_global_root(
+		&stackless_constrs[stackless_count]);
+	stackless_count++;
+	return Val_unit;
 }
 
 // Throw a CamlException in reaction of `exn`
 // If a Java exception is thrown, do not throw a CamlException
+// The backtrace is kept raw, see `CamlException.backtraceElements`
 static void throw_caml_exception(JNIEnv *env, value exn)
 {
 	char			*_exn_msg;
 	jstring			exn_msg;
+	jobject			cause;
+	value			backtrace;
+	jobject			jbacktrace;
 	jthrowable		java_exn;
-	jobjectArray	elements;
 
 	if ((*env)->ExceptionCheck(env))
 		return ;
+	if ((java_exn = find_stackless(exn)) != NULL)
+	{
+		(*env)->Throw(env, java_exn);
+		return ;
+	}
 	// function from caml/printexc.h
 	_exn_msg = caml_format_exception(exn);
 	exn_msg = (*env)->NewStringUTF(env, _exn_msg);
 	caml_stat_free(_exn_msg);
-	elements = alloc_stack_trace_elements(env, get_ocaml_backtrace());
+	cause = get_cause(env, exn);
+	// `exn` is not used after this allocation
+	backtrace = caml_get_exception_raw_backtrace(Val_unit);
+	jbacktrace = (Wosize_val(backtrace) == 0) ? NULL
+		: JVALUE_NEW(env, backtrace);
 	java_exn = (*env)->NewObject(env, CLASS(CamlException),
-			CONSTR(CamlException), exn_msg, get_cause(exn), elements);
+			CONSTR(CamlException), exn_msg, cause, jbacktrace);
 	(*env)->Throw(env, java_exn);
 	(*env)->DeleteLocalRef(env, exn_msg);
-	(*env)->DeleteLocalRef(env, elements);
+	if (jbacktrace != NULL)
+		(*env)->DeleteLocalRef(env, jbacktrace);
 	(*env)->DeleteLocalRef(env, java_exn);
+	if (cause != NULL)
+		(*env)->DeleteLocalRef(env, cause);
+}
+
+// Returns an array of tuple (file_name, line_number)
+static value backtrace_locations(value backtrace)
+{
+	static value const	*locations = NULL;
+
+	if (locations == NULL)
+	{
+		locations = caml_named_value("Java.backtrace_locations");
+		if (locations == NULL)
+			return Atom(0); // Don't fail, just return an empty array
+	}
+	return caml_callback(*locations, backtrace);
+}
+
+jobjectArray Java_juloo_javacaml_CamlException_backtraceElements(JNIEnv *env,
+		jclass c, jobject bt)
+{
+	if (ocaml_java__camljava_env() != env || ocaml_java__in_blocking_call())
+		return NULL;
+	return alloc_stack_trace_elements(env,
+			backtrace_locations(JVALUE_GET(env, bt)));
+	(void)c;
 }
 
 static void init_arg_stack(void)
 {
-	stack = caml_alloc(STACK_MAX_SIZE, 0);
 	caml_register_global_root(&stack);
+	alloc_stack(DEFAULT_STACK_SIZE, DEFAULT_MAX_DEPTH);
+}
+
+void Java_juloo_javacaml_Caml_setCallStackSize(JNIEnv *env, jclass c,
+		jint max_depth, jint size)
+{
+	if (!check_not_blocking(env))
+		return ;
+	if (frame_count > 0)
+	{
+		(*env)->ThrowNew(env, CLASS(IllegalStateException),
+				"Cannot resize the call stack during a call");
+		return ;
+	}
+	if (max_depth < 1 || size < max_depth)
+	{
+		(*env)->ThrowNew(env, CLASS(IllegalArgumentException),
+				"Invalid call stack size");
+		return ;
+	}
+	alloc_stack(size, max_depth);
+	(void)c;
 }
 
 void Java_juloo_javacaml_Caml_function__Ljuloo_javacaml_Value_2(JNIEnv *env,
 		jclass c, jobject v)
 {
+	if (!check_not_blocking(env))
+		return ;
 	if (IS_NULL(env, v))
 		return THROW_NULLPTR(env, "function");
-	Store_field(stack, 0, JVALUE_GET(env, v));
-	stack_size = 1;
+	push_frame(env, JVALUE_GET(env, v));
 	(void)c;
 }
 
@@ -180,12 +488,13 @@ void Java_juloo_javacaml_Caml_function__Ljuloo_javacaml_Callback_2(JNIEnv *env,
 	long func_;
 	value func;
 
+	if (!check_not_blocking(env))
+		return ;
 	if (IS_NULL(env, callback))
 		return THROW_NULLPTR(env, "callback");
 	func_ = (*env)->GetLongField(env, callback, FIELD(Callback, closure));
 	func = *(value*)func_;
-	Store_field(stack, 0, func);
-	stack_size = 1;
+	push_frame(env, func);
 	(void)c;
 }
 
@@ -195,6 +504,8 @@ void Java_juloo_javacaml_Caml_method(JNIEnv *env, jclass c, jobject v,
 	value obj;
 	value method;
 
+	if (!check_not_blocking(env))
+		return ;
 	if (IS_NULL(env, v))
 		return THROW_NULLPTR(env, "object");
 	obj = JVALUE_GET(env, v);
@@ -205,23 +516,49 @@ void Java_juloo_javacaml_Caml_method(JNIEnv *env, jclass c, jobject v,
 				"Method id does not reference any method");
 		return ;
 	}
-	Store_field(stack, 0, method);
-	Store_field(stack, 1, obj);
-	stack_size = 2;
+	if (!push_frame(env, method))
+		return ;
+	if (stack_size >= stack_capacity)
+	{
+		pop_frame();
+		(*env)->ThrowNew(env, CLASS(ArgumentStackOverflowException),
+				"Overflow");
+		return ;
+	}
+	Store_field(stack, stack_size, obj);
+	stack_size++;
 	(void)c;
 }
 
 // Generate a Caml.arg##NAME function
 // `CONVERT` should convert from `TYPE` to an OCaml value
+// The current call is aborted (its frame is removed) if an exception is thrown
 #define ARG(NAME, TYPE, CONVERT) \
 void Java_juloo_javacaml_Caml_arg##NAME(JNIEnv *env, jclass c, TYPE v) \
 { \
-	if (stack_size >= STACK_MAX_SIZE) \
+	value arg; \
+\
+	if (!check_not_blocking(env)) \
+		return ; \
+	if (frame_count == 0) \
+	{ \
+		(*env)->ThrowNew(env, CLASS(IllegalStateException), \
+			"No function to call"); \
+		return ; \
+	} \
+	if (stack_size >= stack_capacity) \
 	{ \
+		pop_frame(); \
 		(*env)->ThrowNew(env, CLASS(ArgumentStackOverflowException), "Overflow"); \
 		return ; \
 	} \
-	Store_field(stack, stack_size, CONVERT(env, v)); \
+	arg = CONVERT(env, v); \
+	if ((*env)->ExceptionCheck(env)) \
+	{ \
+		pop_frame(); \
+		return ; \
+	} \
+	Store_field(stack, stack_size, arg); \
 	stack_size++; \
 	(void)c; \
 }
@@ -229,7 +566,6 @@ void Java_juloo_javacaml_Caml_arg##NAME(JNIEnv *env, jclass c, TYPE v) \
 // a little hack to throw a NullPointerException if the argument is null
 #define CHECK_NULLPTR(env, v, conv) (IS_NULL(env, v) ? \
 		(THROW_NULLPTR(env, "argument"), \
-		stack_size--, \
 		Val_unit) : conv(env, v))
 
 #define ARG_TO_UNIT(env, v)		((void)v, Val_unit)
@@ -262,17 +598,25 @@ TYPE Java_juloo_javacaml_Caml_call##NAME(JNIEnv *env, jclass c) \
 { \
 	value result; \
 \
+	if (!check_not_blocking(env)) \
+		return DUMMY; \
+	if (frame_count == 0) \
+	{ \
+		(*env)->ThrowNew(env, CLASS(IllegalStateException), \
+			"No function to call"); \
+		return DUMMY; \
+	} \
 	if (ocaml_java__camljava_env() != env) \
 	{ \
+		pop_frame(); \
 		(*env)->ThrowNew(env, CLASS(ThreadException), \
 			"Calling OCaml code with a thread other than the main thread"); \
 		return DUMMY; \
 	} \
 \
-	result = caml_callbackN_exn( \
-		Field(stack, 0), stack_size - 1, &Field(stack, 1)); \
+	result = call_frame(); \
 \
-	empty_stack(); \
+	pop_frame(); \
 \
 	if (Is_exception_result(result)) \
 	{ \
@@ -291,7 +635,10 @@ TYPE Java_juloo_javacaml_Caml_call##NAME(JNIEnv *env, jclass c) \
 #define CALL_OF_INT32(env, v)	Int32_val(v)
 #define CALL_OF_INT64(env, v)	Int64_val(v)
 #define CALL_OF_VALUE(env, v)	JVALUE_NEW(env, v)
-#define CALL_OF_OBJECT(env, v)	((v == Java_null_val) ? NULL : Java_obj_val(v))
+// Local objects used outside of their frame are converted to `null`
+// The result is returned to Java, a new local ref (in handle table mode)
+//  is released by the JVM when the native method returns
+#define CALL_OF_OBJECT(env, v)	((v == Java_null_val) ? NULL : Java_obj_get(v))
 CALL(Unit, void, CALL_OF_UNIT,)
 CALL(Int, jint, CALL_OF_INT, 0)
 CALL(Float, jdouble, CALL_OF_FLOAT, 0.0)
@@ -304,6 +651,103 @@ CALL(Object, jobject, CALL_OF_OBJECT, NULL)
 
 #undef CALL
 
+// ========================================================================== //
+// invoke
+// -
+// Calls a function in a single native call, without using the stack
+// `closure` is the pointer stored in a `Callback`
+// `invoke` + the letter of each argument (see `INVOKE_TYPES`),
+//  the result has the type of the arguments
+
+// Throws a ThreadException if `env` is not the env of the main thread
+//  or if it is in a blocking call
+// Must be called before `CAMLparam`, which uses the runtime
+static int check_invoke_thread(JNIEnv *env)
+{
+	if (ocaml_java__camljava_env() != env)
+	{
+		(*env)->ThrowNew(env, CLASS(ThreadException),
+			"Calling OCaml code with a thread other than the main thread");
+		return 0;
+	}
+	return check_not_blocking(env);
+}
+
+// Generate the `Caml.invoke` functions
+// `r` is the result of the callback
+#define INVOKE_RETURN(TYPE, CONVERT, DUMMY) \
+	if (Is_exception_result(r)) \
+	{ \
+		throw_caml_exception(env, Extract_exception(r)); \
+		CAMLreturnT(TYPE, DUMMY); \
+	} \
+	CAMLreturnT(TYPE, CONVERT(env, r));
+
+#define INVOKE(L, TYPE, ARG_TO, CALL_OF, DUMMY) \
+TYPE Java_juloo_javacaml_Caml_invoke##L(JNIEnv *env, jclass c, \
+		jlong closure, TYPE a0) \
+{ \
+	if (!check_invoke_thread(env)) \
+		return DUMMY; \
+	CAMLparam0(); \
+	CAMLlocal1(x); \
+	value r; \
+\
+	x = ARG_TO(env, a0); \
+	r = caml_callback_exn(*(value*)closure, x); \
+	INVOKE_RETURN(TYPE, CALL_OF, DUMMY) \
+	(void)c; \
+} \
+\
+TYPE Java_juloo_javacaml_Caml_invoke##L##L(JNIEnv *env, jclass c, \
+		jlong closure, TYPE a0, TYPE a1) \
+{ \
+	if (!check_invoke_thread(env)) \
+		return DUMMY; \
+	CAMLparam0(); \
+	CAMLlocal2(x, y); \
+	value r; \
+\
+	x = ARG_TO(env, a0); \
+	y = ARG_TO(env, a1); \
+	r = caml_callback2_exn(*(value*)closure, x, y); \
+	INVOKE_RETURN(TYPE, CALL_OF, DUMMY) \
+	(void)c; \
+} \
+\
+TYPE Java_juloo_javacaml_Caml_invoke##L##L##L(JNIEnv *env, jclass c, \
+		jlong closure, TYPE a0, TYPE a1, TYPE a2) \
+{ \
+	if (!check_invoke_thread(env)) \
+		return DUMMY; \
+	CAMLparam0(); \
+	CAMLlocal3(x, y, z); \
+	value r; \
+\
+	x = ARG_TO(env, a0); \
+	y = ARG_TO(env, a1); \
+	z = ARG_TO(env, a2); \
+	r = caml_callback3_exn(*(value*)closure, x, y, z); \
+	INVOKE_RETURN(TYPE, CALL_OF, DUMMY) \
+	(void)c; \
+}
+
+// `long` arguments are OCaml ints, the result is sign-extended
+#define CALL_OF_LONG(env, v)	Long_val(v)
+
+// With params: the letter in the Java signature, Java type,
+//  convertion from Java, convertion to Java and dummy value
+#define INVOKE_TYPES(GEN) \
+	GEN(I, jint, ARG_TO_INT, CALL_OF_INT, 0) \
+	GEN(J, jlong, ARG_TO_INT, CALL_OF_LONG, 0) \
+	GEN(D, jdouble, ARG_TO_FLOAT, CALL_OF_FLOAT, 0.0) \
+	GEN(O, jobject, ARG_TO_OBJECT, CALL_OF_OBJECT, NULL)
+
+INVOKE_TYPES(INVOKE)
+
+#undef INVOKE
+#undef INVOKE_RETURN
+
 // ========================================================================== //
 // getCallback
 
@@ -357,6 +801,7 @@ static JNINativeMethod native_methods[] = {
 	N(startup, "()V",),
 	N(getCallback, "(Ljava/lang/String;)Ljuloo/javacaml/Callback;",),
 	N(hashVariant, "(Ljava/lang/String;)I",),
+	N(setCallStackSize, "(II)V",),
 	N(function, "(Ljuloo/javacaml/Value;)V", __Ljuloo_javacaml_Value_2),
 	N(function, "(Ljuloo/javacaml/Callback;)V", __Ljuloo_javacaml_Callback_2),
 	N(method, "(Ljuloo/javacaml/Value;I)V",),
@@ -378,28 +823,67 @@ static JNINativeMethod native_methods[] = {
 	N(callInt64, "()J",),
 	N(callValue, "()Ljuloo/javacaml/Value;",),
 	N(callObject, "()Ljava/lang/Object;",),
+	N(invokeI, "(JI)I",),
+	N(invokeII, "(JII)I",),
+	N(invokeIII, "(JIII)I",),
+	N(invokeJ, "(JJ)J",),
+	N(invokeJJ, "(JJJ)J",),
+	N(invokeJJJ, "(JJJJ)J",),
+	N(invokeD, "(JD)D",),
+	N(invokeDD, "(JDD)D",),
+	N(invokeDDD, "(JDDD)D",),
+	N(invokeO, "(JLjava/lang/Object;)Ljava/lang/Object;",),
+	N(invokeOO, "(JLjava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;",),
+	N(invokeOOO, "(JLjava/lang/Object;Ljava/lang/Object;"
+		"Ljava/lang/Object;)Ljava/lang/Object;",),
+};
+
+static JNINativeMethod value_native_methods[] = {
+	{ "release", "([JI)V", Java_juloo_javacaml_Value_release },
+};
+
+static JNINativeMethod executor_native_methods[] = {
+	{ "wake", "(I)V", Java_juloo_javacaml_CamlExecutor_wake },
+};
+
+static JNINativeMethod exception_native_methods[] = {
+	{ "backtraceElements",
+		"(Ljuloo/javacaml/Value;)[Ljava/lang/StackTraceElement;",
+		Java_juloo_javacaml_CamlException_backtraceElements },
 };
 
 #undef N
 
 #define COUNT(x) (sizeof(x) / sizeof(*x))
 
-// Native methods must be registered if javacaml is not loaded directly
-//  from Java's `System.loadLibrary`
-int	ocaml_java__javacaml_natives(JNIEnv *env)
+static int	register_natives(JNIEnv *env, char const *class_name,
+				JNINativeMethod *methods, int count)
 {
-	jclass	caml_class;
+	jclass	c;
 	int		r;
 
-	caml_class = (*env)->FindClass(env, "juloo/javacaml/Caml");
-	if (caml_class == NULL)
+	c = (*env)->FindClass(env, class_name);
+	if (c == NULL)
 		return 0;
-	r = (*env)->RegisterNatives(env, caml_class,
-			native_methods, COUNT(native_methods));
-	(*env)->DeleteLocalRef(env, caml_class);
+	r = (*env)->RegisterNatives(env, c, methods, count);
+	(*env)->DeleteLocalRef(env, c);
 	return (r == 0);
 }
 
+// Native methods must be registered if javacaml is not loaded directly
+//  from Java's `System.loadLibrary`
+int	ocaml_java__javacaml_natives(JNIEnv *env)
+{
+	return (register_natives(env, "juloo/javacaml/Caml",
+				native_methods, COUNT(native_methods))
+		&& register_natives(env, "juloo/javacaml/Value",
+				value_native_methods, COUNT(value_native_methods))
+		&& register_natives(env, "juloo/javacaml/CamlExecutor",
+				executor_native_methods, COUNT(executor_native_methods))
+		&& register_natives(env, "juloo/javacaml/CamlException",
+				exception_native_methods, COUNT(exception_native_methods)));
+}
+
 void ocaml_java__javacaml_init()
 {
 	init_arg_stack();
@@ -28,9 +28,18 @@ static inline value copy_some(value v)
 // defined only if built with -DTARGET_JAVACAML
 void ocaml_java__camljava_init(JNIEnv *_env);
 
-// Returns the JNIEnv used by camljava
+// Returns the JNIEnv of the thread that initialised camljava
 JNIEnv *ocaml_java__camljava_env(void);
 
+// Returns true while the calling thread is in a `Jcall.call_blocking_*` call
+// The OCaml runtime lock is released, OCaml code must not run
+int ocaml_java__in_blocking_call(void);
+
+// Returns the JNIEnv of the calling thread
+// The thread is attached to the JVM if it is not already
+// Raises `Failure` if it cannot be attached
+JNIEnv *ocaml_java__env(void);
+
 /*
 ** ========================================================================== **
 ** OCaml value that represent a `jobject` pointer or the `null` value
@@ -42,15 +51,100 @@ JNIEnv *ocaml_java__camljava_env(void);
 ** Java_null_val		`null` value
 ** Java_obj_val_opt(v)	Returns the `jobject` pointer or `null`
 ** alloc_java_obj(obj)	Allocates the value, `obj` is registered as global ref
+** -
+** If built with -DOCAMLJAVA_HANDLE_TABLE, the value stores an index
+** 		in a table of objects instead of a global ref (see `java_stubs.c`)
+** 		`Java_obj_val` returns a new local ref, that the caller must delete
+** -
+** Local objects (see `Java.with_local_frame`) hold a local ref
+** 		and the id of the local frame that owns it
+** 		they use different custom operations, without finalizer
+** Java_obj_val(v)		Raises `Failure` if the frame of `v` is not active
+** 						the call being pushed is dropped (see `drop_call`)
+** Java_obj_val_at(v, mark)	Same but outside of a call, the local refs
+** 						above `mark` are popped before raising
+** Java_obj_get(v)		Same but returns `NULL` instead of raising
+** -
+** `Object.hashCode` and `System.identityHashCode` are cached in the value
+** 		the first time they are computed (see `Java_obj_hashes`)
 */
 
-#define Java_obj_val(v)	(*(jobject*)Data_custom_val(v))
-
 #define Java_null_val	(Val_long(0))
 
+#define Java_obj_val(v)	Java_obj_val_at(v, -1)
+
+#define Java_obj_val_at(v, mark)	(Is_java_local_obj(v) \
+		? ocaml_java__local_obj_val(v, mark) : Java_global_obj_val(v))
+
+#define Java_obj_get(v)	(Is_java_local_obj(v) \
+		? ocaml_java__local_obj_get(v) : Java_global_obj_val(v))
+
 #define Java_obj_val_opt(v)	(((v) == Java_null_val) ? NULL : Java_obj_val(v))
 
+#define Java_obj_val_opt_at(v, mark) \
+	(((v) == Java_null_val) ? NULL : Java_obj_val_at(v, mark))
+
 extern struct custom_operations ocamljava__java_obj_custom_ops;
+extern struct custom_operations ocamljava__java_local_obj_custom_ops;
+
+#define JAVA_OBJ_HASHED				1
+#define JAVA_OBJ_IDENTITY_HASHED	2
+
+struct java_obj_hashes
+{
+	jint		hash;
+	jint		identity_hash;
+	int			flags;
+};
+
+struct java_obj
+{
+#ifdef OCAMLJAVA_HANDLE_TABLE
+	jint					handle;
+#else
+	jobject					obj;
+#endif
+	struct java_obj_hashes	hashes;
+};
+
+struct java_local_obj
+{
+	jobject					obj;
+	intnat					frame;
+	struct java_obj_hashes	hashes;
+};
+
+#define Java_global_obj(v)	((struct java_obj*)Data_custom_val(v))
+#define Java_local_obj(v)	((struct java_local_obj*)Data_custom_val(v))
+
+#define Java_obj_hashes(v)	(Is_java_local_obj(v) \
+		? &Java_local_obj(v)->hashes : &Java_global_obj(v)->hashes)
+
+#define Is_java_local_obj(v) \
+	(Custom_ops_val(v) == &ocamljava__java_local_obj_custom_ops)
+
+// Returns the local ref of a local object
+// or `NULL` if its frame is not active in the current thread
+jobject ocaml_java__local_obj_get(value v);
+
+// Same as `ocaml_java__local_obj_get` but raises `Failure`
+// Pops the local refs above `mark` first, or drops the call if it is `-1`
+jobject ocaml_java__local_obj_val(value v, int mark);
+
+#ifdef OCAMLJAVA_HANDLE_TABLE
+
+# define Java_handle_val(v)	(Java_global_obj(v)->handle)
+
+# define Java_global_obj_val(v)	(ocaml_java__handle_get(env, Java_handle_val(v)))
+
+// Stores `obj` into the table and returns its index
+jint ocaml_java__handle_new(JNIEnv *env, jobject obj);
+
+// Returns a local ref to the object at index `handle`
+jobject ocaml_java__handle_get(JNIEnv *env, jint handle);
+
+// Clears the entry at index `handle`, it can be reused
+void ocaml_java__handle_free(JNIEnv *env, jint handle);
 
 static inline value alloc_java_obj(JNIEnv *env, jobject object)
 {
@@ -58,10 +152,30 @@ static inline value alloc_java_obj(JNIEnv *env, jobject object)
 
 	if ((*env)->IsSameObject(env, object, NULL))
 		return Java_null_val;
-	v = caml_alloc_custom(&ocamljava__java_obj_custom_ops, sizeof(jobject), 0, 1);
-	object = (*env)->NewGlobalRef(env, object);
-	*(jobject*)Data_custom_val(v) = object;
+	v = caml_alloc_custom(&ocamljava__java_obj_custom_ops,
+			sizeof(struct java_obj), 0, 1);
+	Java_handle_val(v) = ocaml_java__handle_new(env, object);
+	Java_global_obj(v)->hashes.flags = 0;
 	return v;
 }
 
+#else
+
+# define Java_global_obj_val(v)	(Java_global_obj(v)->obj)
+
+static inline value alloc_java_obj(JNIEnv *env, jobject object)
+{
+	value v;
+
+	if ((*env)->IsSameObject(env, object, NULL))
+		return Java_null_val;
+	v = caml_alloc_custom(&ocamljava__java_obj_custom_ops,
+			sizeof(struct java_obj), 0, 1);
+	Java_global_obj(v)->obj = (*env)->NewGlobalRef(env, object);
+	Java_global_obj(v)->hashes.flags = 0;
+	return v;
+}
+
+#endif
+
 #endif
@@ -27,6 +27,10 @@ TYPE ocaml_java__##NAME(JNIEnv *env)								\
 	DECL_(jmethodID, NO_WRAP, method_##CLASS_NAME##_##NAME, GetMethodID, \
 		CLASS(CLASS_NAME), #NAME, SIGT)
 
+#define DECL_STATIC_METHOD(CLASS_NAME, NAME, SIGT) \
+	DECL_(jmethodID, NO_WRAP, static_method_##CLASS_NAME##_##NAME, \
+		GetStaticMethodID, CLASS(CLASS_NAME), #NAME, SIGT)
+
 #define DECL_INIT(CLASS_NAME, SIGT) \
 	DECL_(jmethodID, NO_WRAP, init_##CLASS_NAME, GetMethodID, \
 		CLASS(CLASS_NAME), "<init>", SIGT)
@@ -35,4 +39,4 @@ TYPE ocaml_java__##NAME(JNIEnv *env)								\
 	DECL_(jfieldID, NO_WRAP, field_##CLASS_NAME##_##NAME, GetFieldID, \
 		CLASS(CLASS_NAME), #NAME, SIGT)
 
-CLASSES_DECL(DECL_CLASS, DECL_INIT, DECL_FIELD, DECL_METHOD)
+CLASSES_DECL(DECL_CLASS, DECL_INIT, DECL_FIELD, DECL_METHOD, DECL_STATIC_METHOD)
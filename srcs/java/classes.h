@@ -12,6 +12,8 @@
 #define CONSTR(CLASS)			ocaml_java__init_##CLASS(env)
 #define FIELD(CLASS, NAME)		ocaml_java__field_##CLASS##_##NAME(env)
 #define METHOD(CLASS, NAME)		ocaml_java__method_##CLASS##_##NAME(env)
+#define STATIC_METHOD(CLASS, NAME)	\
+	ocaml_java__static_method_##CLASS##_##NAME(env)
 
 /*
 ** ========================================================================== **
@@ -19,8 +21,10 @@
 ** -
 */
 
-#define CLASSES_DECL(_CLASS, _INIT, _FIELD, _METHOD) \
+#define CLASSES_DECL(_CLASS, _INIT, _FIELD, _METHOD, _STATIC_METHOD) \
 	_CLASS("java/lang/", NullPointerException) \
+	_CLASS("java/lang/", IllegalStateException) \
+	_CLASS("java/lang/", IllegalArgumentException) \
 	_CLASS("java/lang/", StackTraceElement) \
 		_INIT(StackTraceElement, "(Ljava/lang/String;Ljava/lang/String;" \
 			"Ljava/lang/String;I)V") \
@@ -33,17 +37,38 @@
 		_METHOD(Object, toString, "()Ljava/lang/String;") \
 		_METHOD(Object, equals, "(Ljava/lang/Object;)Z") \
 		_METHOD(Object, hashCode, "()I") \
+	_CLASS("java/lang/", System) \
+		_STATIC_METHOD(System, identityHashCode, "(Ljava/lang/Object;)I") \
 	_CLASS("juloo/javacaml/", Callback) \
 		_INIT(Callback, "(J)V") \
 		_FIELD(Callback, closure, "J") \
 	_CLASS("juloo/javacaml/", Value) \
 		_INIT(Value, "(J)V") \
 		_FIELD(Value, value, "J") \
+		_STATIC_METHOD(Value, collect, "()V") \
 	_CLASS("juloo/javacaml/", RunnableValue) \
 		_INIT(RunnableValue, "(J)V") \
+	_CLASS("juloo/javacaml/", BufferValue) \
+		_STATIC_METHOD(BufferValue, wrap, \
+			"(Ljava/nio/ByteBuffer;Ljuloo/javacaml/Value;)V") \
+	_CLASS("juloo/javacaml/", StringArrays) \
+		_STATIC_METHOD(StringArrays, split, "([C[I)[Ljava/lang/String;") \
+		_STATIC_METHOD(StringArrays, join, "([Ljava/lang/String;[I)[C") \
+	_CLASS("juloo/javacaml/", CollectionChunks) \
+		_STATIC_METHOD(CollectionChunks, iterator, \
+			"(Ljava/lang/Object;)Ljava/util/Iterator;") \
+		_STATIC_METHOD(CollectionChunks, next, \
+			"(Ljava/util/Iterator;II)Ljava/lang/Object;") \
+		_STATIC_METHOD(CollectionChunks, nextEntries, \
+			"(Ljava/util/Iterator;III)[Ljava/lang/Object;") \
+	_CLASS("juloo/javacaml/", CamlExecutor) \
+		_INIT(CamlExecutor, "(I)V") \
+		_METHOD(CamlExecutor, run, "(I)I") \
 	_CLASS("juloo/javacaml/", CamlException) \
 		_INIT(CamlException, "(Ljava/lang/String;Ljava/lang/Throwable;" \
-			"[Ljava/lang/StackTraceElement;)V") \
+			"Ljuloo/javacaml/Value;)V") \
+		_STATIC_METHOD(CamlException, stackless, \
+			"(Ljava/lang/String;)Ljuloo/javacaml/CamlException;") \
 	_CLASS("juloo/javacaml/", CallbackNotFoundException) \
 	_CLASS("juloo/javacaml/", InvalidMethodIdException) \
 	_CLASS("juloo/javacaml/", ArgumentStackOverflowException) \
@@ -57,11 +82,14 @@
 #define DECL_INIT(C, S)			jmethodID ocaml_java__init_##C(JNIEnv*);
 #define DECL_FIELD(C, N, S)		jfieldID ocaml_java__field_##C##_##N(JNIEnv*);
 #define DECL_METHOD(C, N, S)	jmethodID ocaml_java__method_##C##_##N(JNIEnv*);
+#define DECL_STATIC_METHOD(C, N, S)	\
+	jmethodID ocaml_java__static_method_##C##_##N(JNIEnv*);
 
-CLASSES_DECL(DECL_CLASS, DECL_INIT, DECL_FIELD, DECL_METHOD)
+CLASSES_DECL(DECL_CLASS, DECL_INIT, DECL_FIELD, DECL_METHOD, DECL_STATIC_METHOD)
 
 #undef DECL_CLASS
 #undef DECL_INIT
 #undef DECL_FIELD
 #undef DECL_METHOD
+#undef DECL_STATIC_METHOD
 #undef _ID
@@ -89,6 +89,12 @@ external of_longs : int64 array -> int64 t = "ocaml_java__jarray_of_long"
 external of_chars : char array -> char t = "ocaml_java__jarray_of_char"
 external of_floats : float array -> float t = "ocaml_java__jarray_of_float"
 external of_doubles : float array -> jdouble t = "ocaml_java__jarray_of_double"
+external of_ints_checked : int array -> int t
+	= "ocaml_java__jarray_of_checked_int"
+external of_bytes_checked : int array -> jbyte t
+	= "ocaml_java__jarray_of_checked_byte"
+external of_shorts_checked : int array -> jshort t
+	= "ocaml_java__jarray_of_checked_short"
 (* external of_float_array : floatarray -> float t = "ocaml_java__jarray_of_float" *)
 (* external of_double_array : floatarray -> jdouble t = "ocaml_java__jarray_of_double" *)
 
@@ -100,9 +106,185 @@ let of_array create set src =
 	done;
 	dst
 
-let of_objects cls src = of_array (create_object cls Java.null) set_object src
 let of_values src = of_array create_value set_value src
-let of_strings src = of_array create_string set_string src
+
+external of_strings : string array -> string t
+	= "ocaml_java__jarray_of_strings"
+external of_objects : Java.jclass -> 'a Java.obj array -> 'a Java.obj t
+	= "ocaml_java__jarray_of_objects"
+external to_strings : string t -> string array
+	= "ocaml_java__jarray_to_strings"
+external to_objects : 'a Java.obj t -> 'b Java.obj array
+	= "ocaml_java__jarray_to_objects"
+
+external blit_to_array_int : int t -> int -> int array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_int"
+external blit_to_array_bool : bool t -> int -> bool array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_bool"
+external blit_to_array_byte : jbyte t -> int -> int array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_byte"
+external blit_to_array_short :
+	jshort t -> int -> int array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_short"
+external blit_to_array_int32 :
+	int32 t -> int -> int32 array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_int32"
+external blit_to_array_long :
+	int64 t -> int -> int64 array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_long"
+external blit_to_array_char : char t -> int -> char array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_char"
+external blit_to_array_float :
+	float t -> int -> float array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_float"
+external blit_to_array_double :
+	jdouble t -> int -> float array -> int -> int -> unit
+	= "ocaml_java__jarray_blit_to_array_double"
+
+external blit_of_array_int : int array -> int -> int t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_int"
+external blit_of_array_bool : bool array -> int -> bool t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_bool"
+external blit_of_array_byte : int array -> int -> jbyte t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_byte"
+external blit_of_array_short :
+	int array -> int -> jshort t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_short"
+external blit_of_array_int32 :
+	int32 array -> int -> int32 t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_int32"
+external blit_of_array_long :
+	int64 array -> int -> int64 t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_long"
+external blit_of_array_char : char array -> int -> char t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_char"
+external blit_of_array_float :
+	float array -> int -> float t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_float"
+external blit_of_array_double :
+	float array -> int -> jdouble t -> int -> int -> unit
+	= "ocaml_java__jarray_blit_of_array_double"
+
+external fill_int : int t -> int -> int -> int -> unit
+	= "ocaml_java__jarray_fill_int"
+external fill_bool : bool t -> int -> int -> bool -> unit
+	= "ocaml_java__jarray_fill_bool"
+external fill_byte : jbyte t -> int -> int -> int -> unit
+	= "ocaml_java__jarray_fill_byte"
+external fill_short : jshort t -> int -> int -> int -> unit
+	= "ocaml_java__jarray_fill_short"
+external fill_int32 : int32 t -> int -> int -> int32 -> unit
+	= "ocaml_java__jarray_fill_int32"
+external fill_long : int64 t -> int -> int -> int64 -> unit
+	= "ocaml_java__jarray_fill_long"
+external fill_char : char t -> int -> int -> char -> unit
+	= "ocaml_java__jarray_fill_char"
+external fill_float : float t -> int -> int -> float -> unit
+	= "ocaml_java__jarray_fill_float"
+external fill_double : jdouble t -> int -> int -> float -> unit
+	= "ocaml_java__jarray_fill_double"
+
+external sub_int : int t -> int -> int -> int t = "ocaml_java__jarray_sub_int"
+external sub_bool : bool t -> int -> int -> bool t
+	= "ocaml_java__jarray_sub_bool"
+external sub_byte : jbyte t -> int -> int -> jbyte t
+	= "ocaml_java__jarray_sub_byte"
+external sub_short : jshort t -> int -> int -> jshort t
+	= "ocaml_java__jarray_sub_short"
+external sub_int32 : int32 t -> int -> int -> int32 t
+	= "ocaml_java__jarray_sub_int32"
+external sub_long : int64 t -> int -> int -> int64 t
+	= "ocaml_java__jarray_sub_long"
+external sub_char : char t -> int -> int -> char t
+	= "ocaml_java__jarray_sub_char"
+external sub_float : float t -> int -> int -> float t
+	= "ocaml_java__jarray_sub_float"
+external sub_double : jdouble t -> int -> int -> jdouble t
+	= "ocaml_java__jarray_sub_double"
+
+external to_bigarray_int :
+	int t -> (int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_int"
+external to_bigarray_bool :
+	bool t ->
+	(int, Bigarray.int8_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_bool"
+external to_bigarray_byte :
+	jbyte t ->
+	(int, Bigarray.int8_signed_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_byte"
+external to_bigarray_short :
+	jshort t ->
+	(int, Bigarray.int16_signed_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_short"
+external to_bigarray_int32 :
+	int32 t -> (int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_int32"
+external to_bigarray_long :
+	int64 t -> (int64, Bigarray.int64_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_long"
+external to_bigarray_char :
+	char t ->
+	(int, Bigarray.int16_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_char"
+external to_bigarray_float :
+	float t ->
+	(float, Bigarray.float32_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_float"
+external to_bigarray_double :
+	jdouble t ->
+	(float, Bigarray.float64_elt, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jarray_to_bigarray_double"
+
+external of_bigarray_int :
+	(int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t -> int t
+	= "ocaml_java__jarray_of_bigarray_int"
+external of_bigarray_bool :
+	(int, Bigarray.int8_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	bool t
+	= "ocaml_java__jarray_of_bigarray_bool"
+external of_bigarray_byte :
+	(int, Bigarray.int8_signed_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	jbyte t
+	= "ocaml_java__jarray_of_bigarray_byte"
+external of_bigarray_short :
+	(int, Bigarray.int16_signed_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	jshort t
+	= "ocaml_java__jarray_of_bigarray_short"
+external of_bigarray_int32 :
+	(int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t -> int32 t
+	= "ocaml_java__jarray_of_bigarray_int32"
+external of_bigarray_long :
+	(int64, Bigarray.int64_elt, Bigarray.c_layout) Bigarray.Array1.t -> int64 t
+	= "ocaml_java__jarray_of_bigarray_long"
+external of_bigarray_char :
+	(int, Bigarray.int16_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	char t
+	= "ocaml_java__jarray_of_bigarray_char"
+external of_bigarray_float :
+	(float, Bigarray.float32_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	float t
+	= "ocaml_java__jarray_of_bigarray_float"
+external of_bigarray_double :
+	(float, Bigarray.float64_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	jdouble t
+	= "ocaml_java__jarray_of_bigarray_double"
+
+let to_array zero blit src =
+	let len = length src in
+	let dst = Array.make len zero in
+	blit src 0 dst 0 len;
+	dst
+
+let to_ints src = to_array 0 blit_to_array_int src
+let to_bools src = to_array false blit_to_array_bool src
+let to_bytes src = to_array 0 blit_to_array_byte src
+let to_shorts src = to_array 0 blit_to_array_short src
+let to_int32s src = to_array 0l blit_to_array_int32 src
+let to_longs src = to_array 0L blit_to_array_long src
+let to_chars src = to_array '\000' blit_to_array_char src
+let to_floats src = to_array 0. blit_to_array_float src
+let to_doubles src = to_array 0. blit_to_array_double src
 
 external _of_obj : _ Java.obj -> 'a t = "%identity"
 let of_obj obj =
@@ -9,7 +9,10 @@ type jdouble
 type 'a jvalue
 
 (** Creates a Java array by copying an OCaml array
-	Raises `Failure` if the allocation fail *)
+	`of_strings` and `of_objects` copy the whole array in a single call
+	Raises `Failure` if the allocation fail
+	`of_objects` raises `Invalid_argument` if an object
+		is not an instance of the class *)
 val of_ints : int array -> int t
 val of_bools : bool array -> bool t
 val of_bytes : int array -> jbyte t
@@ -23,6 +26,137 @@ val of_strings : string array -> string t
 val of_values : 'a array -> 'a jvalue t
 val of_objects : Java.jclass -> 'a Java.obj array -> 'a Java.obj t
 
+(** Same as `of_ints`, `of_bytes` and `of_shorts`
+		but the values are not truncated
+	Raises `Invalid_argument` if a value does not fit in the Java type *)
+val of_ints_checked : int array -> int t
+val of_bytes_checked : int array -> jbyte t
+val of_shorts_checked : int array -> jshort t
+
+(** Creates an OCaml array by copying a Java array
+	The array is read in a single JNI call *)
+val to_ints : int t -> int array
+val to_bools : bool t -> bool array
+val to_bytes : jbyte t -> int array
+val to_shorts : jshort t -> int array
+val to_int32s : int32 t -> int32 array
+val to_longs : int64 t -> int64 array
+val to_chars : char t -> char array
+val to_floats : float t -> float array
+val to_doubles : jdouble t -> float array
+
+(** Same for object arrays, in a single call
+	`to_strings` raises `Failure` if an element is `null`,
+	`null` elements of `to_objects` are `Java.null` *)
+val to_strings : string t -> string array
+val to_objects : 'a Java.obj t -> 'b Java.obj array
+
+(** `blit_to_array_int src src_pos dst dst_pos len`
+	Copies `len` elements from the Java array `src`, starting at `src_pos`,
+		to the OCaml array `dst`, starting at `dst_pos`
+	`blit_of_array_int` copies in the other direction
+	The whole range is copied in a single JNI call
+	Raises `Invalid_argument` if one of the ranges is out of bounds *)
+val blit_to_array_int : int t -> int -> int array -> int -> int -> unit
+val blit_to_array_bool : bool t -> int -> bool array -> int -> int -> unit
+val blit_to_array_byte : jbyte t -> int -> int array -> int -> int -> unit
+val blit_to_array_short : jshort t -> int -> int array -> int -> int -> unit
+val blit_to_array_int32 : int32 t -> int -> int32 array -> int -> int -> unit
+val blit_to_array_long : int64 t -> int -> int64 array -> int -> int -> unit
+val blit_to_array_char : char t -> int -> char array -> int -> int -> unit
+val blit_to_array_float : float t -> int -> float array -> int -> int -> unit
+val blit_to_array_double : jdouble t -> int -> float array -> int -> int -> unit
+val blit_of_array_int : int array -> int -> int t -> int -> int -> unit
+val blit_of_array_bool : bool array -> int -> bool t -> int -> int -> unit
+val blit_of_array_byte : int array -> int -> jbyte t -> int -> int -> unit
+val blit_of_array_short : int array -> int -> jshort t -> int -> int -> unit
+val blit_of_array_int32 : int32 array -> int -> int32 t -> int -> int -> unit
+val blit_of_array_long : int64 array -> int -> int64 t -> int -> int -> unit
+val blit_of_array_char : char array -> int -> char t -> int -> int -> unit
+val blit_of_array_float : float array -> int -> float t -> int -> int -> unit
+val blit_of_array_double : float array -> int -> jdouble t -> int -> int -> unit
+
+(** `fill_int array pos len x` Sets the `len` elements starting at `pos` to `x`
+	Raises `Invalid_argument` if the range is out of bounds *)
+val fill_int : int t -> int -> int -> int -> unit
+val fill_bool : bool t -> int -> int -> bool -> unit
+val fill_byte : jbyte t -> int -> int -> int -> unit
+val fill_short : jshort t -> int -> int -> int -> unit
+val fill_int32 : int32 t -> int -> int -> int32 -> unit
+val fill_long : int64 t -> int -> int -> int64 -> unit
+val fill_char : char t -> int -> int -> char -> unit
+val fill_float : float t -> int -> int -> float -> unit
+val fill_double : jdouble t -> int -> int -> float -> unit
+
+(** `sub_int array pos len` Creates a new Java array
+		containing the `len` elements starting at `pos`
+	Raises `Invalid_argument` if the range is out of bounds
+	Raises `Out_of_memory` if the allocation fail *)
+val sub_int : int t -> int -> int -> int t
+val sub_bool : bool t -> int -> int -> bool t
+val sub_byte : jbyte t -> int -> int -> jbyte t
+val sub_short : jshort t -> int -> int -> jshort t
+val sub_int32 : int32 t -> int -> int -> int32 t
+val sub_long : int64 t -> int -> int -> int64 t
+val sub_char : char t -> int -> int -> char t
+val sub_float : float t -> int -> int -> float t
+val sub_double : jdouble t -> int -> int -> jdouble t
+
+(** Copies a Java array to a new Bigarray and back
+	The Bigarray kind has the same representation as the Java type,
+		the data is copied in a single JNI call
+	`bool` arrays are copied as bytes, the values must be 0 or 1
+	`of_bigarray_*` raises `Failure` if the allocation fail
+	See `Jbuffer` to share the memory instead of copying *)
+val to_bigarray_int :
+	int t -> (int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_bool :
+	bool t ->
+	(int, Bigarray.int8_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_byte :
+	jbyte t ->
+	(int, Bigarray.int8_signed_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_short :
+	jshort t ->
+	(int, Bigarray.int16_signed_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_int32 :
+	int32 t -> (int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_long :
+	int64 t -> (int64, Bigarray.int64_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_char :
+	char t ->
+	(int, Bigarray.int16_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_float :
+	float t ->
+	(float, Bigarray.float32_elt, Bigarray.c_layout) Bigarray.Array1.t
+val to_bigarray_double :
+	jdouble t ->
+	(float, Bigarray.float64_elt, Bigarray.c_layout) Bigarray.Array1.t
+val of_bigarray_int :
+	(int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t -> int t
+val of_bigarray_bool :
+	(int, Bigarray.int8_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	bool t
+val of_bigarray_byte :
+	(int, Bigarray.int8_signed_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	jbyte t
+val of_bigarray_short :
+	(int, Bigarray.int16_signed_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	jshort t
+val of_bigarray_int32 :
+	(int32, Bigarray.int32_elt, Bigarray.c_layout) Bigarray.Array1.t -> int32 t
+val of_bigarray_long :
+	(int64, Bigarray.int64_elt, Bigarray.c_layout) Bigarray.Array1.t -> int64 t
+val of_bigarray_char :
+	(int, Bigarray.int16_unsigned_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	char t
+val of_bigarray_float :
+	(float, Bigarray.float32_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	float t
+val of_bigarray_double :
+	(float, Bigarray.float64_elt, Bigarray.c_layout) Bigarray.Array1.t ->
+	jdouble t
+
 (** `create_int 4` Creates an array holding 4 ints
 	All elements are initialized with a default value
 	Warning: `string` and `value` arrays are filled with `null`,
@@ -12,8 +12,8 @@ let null = Obj.magic 0
 
 let () =
 	(* Used by javacaml to handle uncaught exceptions *)
-	Callback.register "Java.get_ocaml_backtraces" Printexc.(fun () ->
-		match backtrace_slots (get_raw_backtrace ()) with
+	Callback.register "Java.backtrace_locations" Printexc.(fun bt ->
+		match backtrace_slots bt with
 		| Some bt	->
 			Array.map (fun slot ->
 				match Slot.location slot with
@@ -21,9 +21,6 @@ let () =
 				| None		-> ("Unknown location", -1)) bt
 		| None		-> [||]
 	);
-	Callback.register "Java.get_cause" (function
-		| Exception thr	-> Some thr
-		| _				-> None);
 	Callback.register_exception "Java.Exception" (Exception (Obj.magic 0))
 
 external instanceof : _ obj -> jclass -> bool
@@ -39,3 +36,72 @@ external compare : 'a obj -> 'a obj -> int = "ocaml_java__compare"
 external to_string : 'a obj -> string = "ocaml_java__to_string"
 external equals : 'a obj -> 'a obj -> bool = "ocaml_java__equals"
 external hash_code : 'a obj -> int = "ocaml_java__hash_code"
+
+external identity_hash : 'a obj -> int
+	= "ocaml_java__identity_hash" [@@noalloc]
+
+external flush_released : unit -> unit
+	= "ocaml_java__flush_released"
+
+external register_stackless : exn -> unit = "ocaml_java__register_stackless"
+
+external push_local_frame : unit -> unit = "ocaml_java__push_local_frame"
+external pop_local_frame : unit -> unit = "ocaml_java__pop_local_frame"
+
+let with_local_frame f =
+	push_local_frame ();
+	match f () with
+	| r				-> pop_local_frame (); r
+	| exception e	-> pop_local_frame (); raise e
+
+external global : 'a obj -> 'a obj = "ocaml_java__global"
+
+module Obj_table =
+struct
+
+	module H = Hashtbl.Make (struct
+		type t = unit obj
+		let equal a b =
+			a == b || (identity_hash a = identity_hash b && sameobject a b)
+		let hash = identity_hash
+	end)
+
+	type ('a, 'b) t = 'b H.t
+
+	external key : 'a obj -> unit obj = "%identity"
+	external of_key : unit obj -> 'a obj = "%identity"
+
+	let create = H.create
+	let clear = H.clear
+	let reset = H.reset
+	let copy = H.copy
+	let add t k v = H.add t (key k) v
+	let remove t k = H.remove t (key k)
+	let find t k = H.find t (key k)
+	let find_opt t k = H.find_opt t (key k)
+	let find_all t k = H.find_all t (key k)
+	let replace t k v = H.replace t (key k) v
+	let mem t k = H.mem t (key k)
+	let iter f t = H.iter (fun k v -> f (of_key k) v) t
+	let fold f t acc = H.fold (fun k v acc -> f (of_key k) v acc) t acc
+	let length = H.length
+
+end
+
+module Intern =
+struct
+
+	type stats = {
+		to_java_hits : int;
+		to_java_misses : int;
+		of_java_hits : int;
+		of_java_misses : int
+	}
+
+	external set_size : int -> unit = "ocaml_java__intern_set_size"
+	external size : unit -> int = "ocaml_java__intern_size"
+	external stats : unit -> stats = "ocaml_java__intern_stats"
+	external reset_stats : unit -> unit
+		= "ocaml_java__intern_reset_stats" [@@noalloc]
+
+end
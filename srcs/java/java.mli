@@ -4,6 +4,9 @@
 	The `'a` (phantom) parameter is to embed custom types
 	Does not support marshalling
 	Polymorphic hash is implemented by calling Java's Object.hashCode
+		The hash is computed once and cached in the value,
+		objects whose hashCode can change should not be used as keys
+		(see `Obj_table`)
 	Polymorphic compare is implemented using Java's Comparable interface
 		It has a few differences with `compare`:
 		- Objects with the exact same reference are considered equals
@@ -59,5 +62,109 @@ val to_string : 'a obj -> string
 val equals : 'a obj -> 'a obj -> bool
 
 (** Binding for `Object.hashCode()`
-	Raises `Failure` if the object is `null` *)
+	The result is cached in the object
+	Returns `0` if the object is `null` *)
 val hash_code : 'a obj -> int
+
+(** Binding for `System.identityHashCode(o)`
+	The result is cached in the object
+	Returns `0` if the object is `null` *)
+external identity_hash : 'a obj -> int
+	= "ocaml_java__identity_hash" [@@noalloc]
+
+(** Release the Java objects that have been garbage collected
+	The references held by dead objects are not released by the GC
+		but queued and released in batches, at the start of a Java call
+		or when the queue is full
+	This releases them immediately
+	It also releases the OCaml values held by the `Value` objects
+		that the Java GC has collected *)
+external flush_released : unit -> unit
+	= "ocaml_java__flush_released"
+
+(** `register_stackless exn`
+	OCaml exceptions not caught when called from Java
+		are thrown as a `CamlException` with the OCaml backtrace
+	Exceptions with the same constructor as `exn` are instead thrown
+		as a single preallocated `CamlException`, without stack trace,
+		whose message is the message of `exn` (the arguments are ignored)
+	For exceptions used for control flow (eg. `Not_found`) *)
+external register_stackless : exn -> unit = "ocaml_java__register_stackless"
+
+(** `with_local_frame f` calls `f` inside a local frame
+	The objects returned by the `_local` functions (eg. Jcall.call_object_local)
+		inside the frame are cheap local references
+		that are all released when `f` returns (or raises)
+	Using them after that raises `Failure`
+		(`instanceof` returns `false` for them
+		and `sameobject` never sees them as the same object)
+	Local objects are local to the thread that created them
+	Frames can be nested *)
+val with_local_frame : (unit -> 'a) -> 'a
+
+(** Returns an object that can be used outside of its local frame
+	Returns the object itself if it is not a local object *)
+external global : 'a obj -> 'a obj = "ocaml_java__global"
+
+(** Hash tables keyed by Java objects, using the identity of the objects
+		(`identity_hash` and `sameobject`) instead of `hashCode` and `equals`
+	Lookups do not call Java once the hash of the key is cached
+	See the `Hashtbl` module for the documentation of the functions *)
+module Obj_table :
+sig
+
+	(** A table from `'a obj` to `'b` *)
+	type ('a, 'b) t
+
+	val create : int -> ('a, 'b) t
+	val clear : ('a, 'b) t -> unit
+	val reset : ('a, 'b) t -> unit
+	val copy : ('a, 'b) t -> ('a, 'b) t
+	val add : ('a, 'b) t -> 'a obj -> 'b -> unit
+	val remove : ('a, 'b) t -> 'a obj -> unit
+	val find : ('a, 'b) t -> 'a obj -> 'b
+	val find_opt : ('a, 'b) t -> 'a obj -> 'b option
+	val find_all : ('a, 'b) t -> 'a obj -> 'b list
+	val replace : ('a, 'b) t -> 'a obj -> 'b -> unit
+	val mem : ('a, 'b) t -> 'a obj -> bool
+	val iter : ('a obj -> 'b -> unit) -> ('a, 'b) t -> unit
+	val fold : ('a obj -> 'b -> 'c -> 'c) -> ('a, 'b) t -> 'c -> 'c
+	val length : ('a, 'b) t -> int
+
+end
+
+(** Cache for the strings that often cross the boundary (keys, enum names)
+	Used by the `_interned` functions of `Jcall`
+		and the `string [@java.interned]` type of the ppx
+	`to_java` maps the content of OCaml strings to Java Strings
+	`of_java` maps Java Strings, by identity, to OCaml strings:
+		the same OCaml string may be returned many times,
+		it must not be modified with unsafe functions
+	Each table has `size` entries, a new string replaces the one in its slot
+	The cache is disabled by default *)
+module Intern :
+sig
+
+	type stats = {
+		to_java_hits : int;
+		to_java_misses : int;
+		of_java_hits : int;
+		of_java_misses : int
+	}
+
+	(** Set the number of entries of each table, rounded up to a power of 2
+		The cache is cleared, `0` disables it
+		Raises `Invalid_argument` if the size is negative *)
+	external set_size : int -> unit = "ocaml_java__intern_set_size"
+
+	(** Returns the number of entries of each table, `0` if disabled *)
+	external size : unit -> int = "ocaml_java__intern_size"
+
+	(** Returns the counters of hits and misses since the last `reset_stats`
+		Lookups are not counted while the cache is disabled *)
+	external stats : unit -> stats = "ocaml_java__intern_stats"
+
+	external reset_stats : unit -> unit
+		= "ocaml_java__intern_reset_stats" [@@noalloc]
+
+end
@@ -1,18 +1,423 @@
 #include "camljava_utils.h"
 #include "classes.h"
 #include "javacaml_utils.h"
+#include "ocamljava_stubs.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <jni.h>
+#include <poll.h>
+#include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <caml/alloc.h>
+#include <caml/bigarray.h>
 #include <caml/callback.h>
 #include <caml/custom.h>
 #include <caml/fail.h>
 #include <caml/memory.h>
 #include <caml/mlvalues.h>
+#include <caml/signals.h>
+#include <caml/threads.h>
 
-static JNIEnv *env;
+/*
+** ========================================================================== **
+** Threads
+** -
+** Each thread uses its own JNIEnv
+** Threads are attached to the JVM lazily, the first time they need an env
+** Threads attached that way are detached when they exit
+** -
+** `main_env` is the env of the thread that initialised camljava
+** Each function reads the env of the current thread once into a local `env`:
+** 		`current_env` raises `Failure` if the thread cannot be attached
+** 		`current_env_noraise` aborts instead, it is used by the noalloc stubs,
+** 		the finalizers and the helpers, where raising is not allowed
+*/
+
+static JavaVM *jvm = NULL;
+static JNIEnv *main_env = NULL;
+
+static __thread JNIEnv *thread_env = NULL;
+
+// Holds a non-NULL value for threads that have been attached by `attach_thread`
+static pthread_key_t attached_key;
+
+static void free_stacks(void);
+static void drop_call(void);
+
+static void detach_thread(void *e)
+{
+	free_stacks();
+	(*jvm)->DetachCurrentThread(jvm);
+	(void)e;
+}
+
+// Returns `NULL` on error
+static JNIEnv *attach_thread(void)
+{
+	JNIEnv *e;
+
+	if (jvm == NULL)
+		return NULL;
+	if ((*jvm)->GetEnv(jvm, (void**)&e, JNI_VERSION_1_4) != JNI_OK)
+	{
+		if ((*jvm)->AttachCurrentThread(jvm, (void**)&e, NULL) != JNI_OK)
+			return NULL;
+		pthread_setspecific(attached_key, e);
+	}
+	thread_env = e;
+	return e;
+}
+
+// The arguments pushed by the thread are dropped before raising
+static JNIEnv *current_env(void)
+{
+	JNIEnv *const	e = thread_env;
+
+	if (e != NULL)
+		return e;
+	if (attach_thread() != NULL)
+		return thread_env;
+	drop_call();
+	if (jvm == NULL)
+		caml_failwith("Java is not initialized");
+	caml_failwith("Java: Failed to attach the current thread");
+	return NULL;
+}
+
+static JNIEnv *current_env_noraise(void)
+{
+	JNIEnv *const	e = thread_env;
+
+	if (e != NULL)
+		return e;
+	if (attach_thread() == NULL)
+		caml_fatal_error("ocaml-java: cannot attach the current thread");
+	return thread_env;
+}
+
+/*
+** ========================================================================== **
+** Released objects
+** -
+** The finalizer of Java.obj does not release the global ref (or the handle)
+** 		itself, it is queued in `released` and released later in batches:
+** 		when the buffer is full, at the start of a call if there are at least
+** 		`RELEASED_BATCH_SIZE` refs queued or by `Java.flush_released`
+** -
+** The finalizer and the stubs run while holding the OCaml runtime lock,
+** 		the buffer needs no other lock
+*/
+
+#define RELEASED_BUFFER_SIZE	1024
+#define RELEASED_BATCH_SIZE		64
+
+#ifdef OCAMLJAVA_HANDLE_TABLE
+# define RELEASED_T						jint
+# define RELEASE_REF(e, r)				ocaml_java__handle_free(e, r)
+#else
+# define RELEASED_T						jobject
+# define RELEASE_REF(e, r)				(*e)->DeleteGlobalRef(e, r)
+#endif
+
+static RELEASED_T released[RELEASED_BUFFER_SIZE];
+static int released_count = 0;
+
+static void check_exceptions(void);
+
+static void flush_released(void)
+{
+	JNIEnv *const	env = current_env_noraise();
+	int				i;
+
+	for (i = 0; i < released_count; i++)
+		RELEASE_REF(env, released[i]);
+	released_count = 0;
+}
+
+static void queue_released(RELEASED_T r)
+{
+	if (released_count >= RELEASED_BUFFER_SIZE)
+		flush_released();
+	released[released_count++] = r;
+}
+
+// Also releases the Values of the collected Java objects,
+//  which calls into Java, the stub is not noalloc
+value ocaml_java__flush_released(value unit)
+{
+	JNIEnv *const	env = current_env();
+
+	flush_released();
+	ocaml_java__jvalue_collect(env);
+	check_exceptions();
+	return Val_unit;
+	(void)unit;
+}
+
+/*
+** ========================================================================== **
+** Calling
+** -
+** `arg_stack` represents the argument stack
+** `local_ref_stack` stores references to objects allocated in `push_` functions
+** `arg_is_obj` flags the arguments that are objects, in parallel to `arg_stack`
+** Both stacks grow on demand
+** -
+** A call uses the arguments and local refs pushed since the start of
+** 		the current frame (`arg_base` and `local_ref_base`)
+** `begin_call` starts a new frame above them for the duration of the call
+** 		so that nested calls (eg. from a callback) do not clobber them
+** 		and `end_call` pops the call, releasing its local refs only
+** The stacks are local to each thread
+*/
+
+#define ARG_STACK_INITIAL_SIZE	16
+#define LOCALREF_STACK_INITIAL_SIZE	32
+
+static __thread jvalue *arg_stack = NULL;
+static __thread char *arg_is_obj = NULL;
+static __thread int arg_capacity = 0;
+static __thread int arg_count = 0;
+static __thread int arg_base = 0;
+
+static __thread jobject *local_ref_stack = NULL;
+static __thread int local_ref_capacity = 0;
+static __thread int local_ref_count = 0;
+static __thread int local_ref_base = 0;
+
+// Saved by `begin_call` on the C stack, restored by `end_call`
+struct call_frame
+{
+	int			arg_base;
+	int			local_ref_base;
+};
+
+// Double the capacity of a stack
+// `push_` functions are noalloc and cannot raise, failing is fatal
+static void *grow_stack(void *stack, int *capacity, int initial_size,
+		size_t elem_size)
+{
+	int const	new_capacity = (*capacity == 0) ? initial_size : *capacity * 2;
+
+	stack = realloc(stack, new_capacity * elem_size);
+	if (stack == NULL)
+		caml_fatal_error("ocaml-java: calling stack overflow");
+	*capacity = new_capacity;
+	return stack;
+}
+
+// Returns a new slot on the argument stack
+// `is_obj` is set if the argument is an object (the `l` field)
+static jvalue *push_arg(int is_obj)
+{
+	int		capacity;
+
+	if (arg_count >= arg_capacity)
+	{
+		capacity = arg_capacity;
+		arg_is_obj = grow_stack(arg_is_obj, &capacity,
+				ARG_STACK_INITIAL_SIZE, sizeof(char));
+		arg_stack = grow_stack(arg_stack, &arg_capacity,
+				ARG_STACK_INITIAL_SIZE, sizeof(jvalue));
+	}
+	arg_is_obj[arg_count] = is_obj;
+	return &arg_stack[arg_count++];
+}
+
+// Adds a local ref onto the stack and returns it
+// The JVM is asked for enough local ref capacity when the stack grows
+static jobject push_local_ref(jobject obj)
+{
+	JNIEnv	*env;
+
+	if (local_ref_count >= local_ref_capacity)
+	{
+		local_ref_stack = grow_stack(local_ref_stack, &local_ref_capacity,
+				LOCALREF_STACK_INITIAL_SIZE, sizeof(jobject));
+		env = current_env_noraise();
+		if ((*env)->EnsureLocalCapacity(env, local_ref_capacity) != 0)
+			caml_fatal_error("ocaml-java: cannot allocate local refs");
+	}
+	local_ref_stack[local_ref_count++] = obj;
+	return obj;
+}
+
+// Deletes the local refs above `base` and pop them
+// The env is not needed if there is nothing to delete
+static void pop_local_refs(int base)
+{
+	JNIEnv	*env;
+	int		i;
+
+	if (base >= local_ref_count)
+		return ;
+	env = current_env_noraise();
+	for (i = base; i < local_ref_count; i++)
+		(*env)->DeleteLocalRef(env, local_ref_stack[i]);
+	local_ref_count = base;
+}
+
+// Must be called before calling a java method
+// Returns the arguments of the call
+static jvalue *begin_call(struct call_frame *frame)
+{
+	jvalue *const	args = arg_stack + arg_base;
+
+	if (released_count >= RELEASED_BATCH_SIZE)
+		flush_released();
+	frame->arg_base = arg_base;
+	frame->local_ref_base = local_ref_base;
+	arg_base = arg_count;
+	local_ref_base = local_ref_count;
+	return args;
+}
+
+// Must be called after the call returned
+// Release the arguments and the local refs of the call
+static void end_call(struct call_frame const *frame)
+{
+	pop_local_refs(frame->local_ref_base);
+	arg_count = frame->arg_base;
+	arg_base = frame->arg_base;
+	local_ref_base = frame->local_ref_base;
+}
+
+// Drops the arguments and the local refs pushed for the current call
+// Must be called before raising an exception instead of making the call
+static void drop_call(void)
+{
+	pop_local_refs(local_ref_base);
+	arg_count = arg_base;
+}
+
+// Replaces the object arguments of the current call by new local refs
+// Must be called before `begin_call` by the calls that release the runtime:
+//  the pushed objects are no longer reachable from OCaml
+//  and their global ref can be deleted by a finalizer during the call
+// The new local refs are released by `end_call`
+static void resolve_obj_args(JNIEnv *env)
+{
+	int		i;
+
+	for (i = arg_base; i < arg_count; i++)
+		if (arg_is_obj[i] && arg_stack[i].l != NULL)
+			arg_stack[i].l = push_local_ref(
+					(*env)->NewLocalRef(env, arg_stack[i].l));
+}
+
+/*
+** ========================================================================== **
+** Local frames
+** -
+** `Java.with_local_frame` pushes a JNI local frame
+** 		objects returned by the `_local` functions are local refs
+** 		owned by the current frame (see `alloc_local_obj`)
+** 		and released all at once when the frame is popped
+** `local_frames` stores the active frames of the thread
+** 		a local object can be used only while its frame is in this stack
+** 		the refs and arguments left above the frame's marks (eg. by a call
+** 		that raised) are dropped before the JNI frame is popped
+** Ids are unique (`next_frame_id` is protected by the OCaml runtime lock)
+*/
+
+#define LOCAL_FRAME_CAPACITY	16
+#define LOCAL_FRAMES_INITIAL_SIZE	8
+
+static intnat next_frame_id = 1;
+
+struct local_frame
+{
+	intnat		id;
+	int			arg_count;
+	int			local_ref_count;
+};
+
+static __thread struct local_frame *local_frames = NULL;
+static __thread int local_frame_capacity = 0;
+static __thread int local_frame_count = 0;
+
+value ocaml_java__push_local_frame(value unit)
+{
+	JNIEnv *const		env = current_env();
+	struct local_frame	*frame;
+
+	if (local_frame_count >= local_frame_capacity)
+		local_frames = grow_stack(local_frames, &local_frame_capacity,
+				LOCAL_FRAMES_INITIAL_SIZE, sizeof(struct local_frame));
+	if ((*env)->PushLocalFrame(env, LOCAL_FRAME_CAPACITY) != 0)
+		caml_failwith("Java.with_local_frame: Cannot allocate local frame");
+	frame = &local_frames[local_frame_count++];
+	frame->id = next_frame_id++;
+	frame->arg_count = arg_count;
+	frame->local_ref_count = local_ref_count;
+	return Val_unit;
+	(void)unit;
+}
+
+value ocaml_java__pop_local_frame(value unit)
+{
+	JNIEnv *const		env = current_env();
+	struct local_frame	*frame;
+
+	if (local_frame_count <= 0)
+		caml_failwith("Java.with_local_frame: No local frame");
+	frame = &local_frames[--local_frame_count];
+	if (arg_count > frame->arg_count)
+		arg_count = frame->arg_count;
+	pop_local_refs(frame->local_ref_count);
+	(*env)->PopLocalFrame(env, NULL);
+	return Val_unit;
+	(void)unit;
+}
+
+jobject ocaml_java__local_obj_get(value v)
+{
+	struct java_local_obj const *const	l = Java_local_obj(v);
+	int									i;
+
+	for (i = local_frame_count - 1; i >= 0; i--)
+		if (local_frames[i].id == l->frame)
+			return l->obj;
+	return NULL;
+}
+
+jobject ocaml_java__local_obj_val(value v, int mark)
+{
+	jobject const obj = ocaml_java__local_obj_get(v);
+
+	if (obj == NULL)
+	{
+		if (mark < 0)
+			drop_call();
+		else
+			pop_local_refs(mark);
+		caml_failwith("Java: Local object used outside of its frame");
+	}
+	return obj;
+}
+
+// Free the stacks of the current thread, called when it exits
+static void free_stacks(void)
+{
+	free(arg_stack);
+	free(arg_is_obj);
+	free(local_ref_stack);
+	free(local_frames);
+	arg_stack = NULL;
+	arg_is_obj = NULL;
+	local_ref_stack = NULL;
+	local_frames = NULL;
+	arg_capacity = 0;
+	local_ref_capacity = 0;
+	local_frame_capacity = 0;
+}
 
 /*
 ** ========================================================================== **
@@ -25,6 +430,8 @@ static value raise_java_exception(jthrowable exn)
 {
 	CAMLparam0();
 	CAMLlocal1(thrbl);
+	JNIEnv *const	env = current_env_noraise();
+
 	thrbl = alloc_java_obj(env, exn);
 	(*env)->DeleteLocalRef(env, exn);
 	if (java_exception == NULL)
@@ -41,10 +448,12 @@ static value raise_java_exception(jthrowable exn)
 // if there is, raises Java.Exception
 static void check_exceptions(void)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	jthrowable exn;
 
+	if (!(*env)->ExceptionCheck(env)) return ;
 	exn = (*env)->ExceptionOccurred(env);
-	if (exn == NULL) return ;
 	(*env)->ExceptionClear(env);
 	raise_java_exception(exn);
 }
@@ -55,39 +464,189 @@ static void check_exceptions(void)
 ** Hold a reference to a Java object
 */
 
+#ifdef OCAMLJAVA_HANDLE_TABLE
+
+/*
+** Handle table
+** -
+** Objects are stored in Java arrays of `HANDLE_SLAB_SIZE` elements (slabs)
+** 		each slab is held by a global ref
+** A handle is an index in the table: slab index and offset in the slab
+** Free entries are linked through `handle_next`
+** 		a new slab is allocated when there is no free entry
+** -
+** The table is shared by all threads, it is protected by the OCaml runtime
+** 		lock (handles are allocated and freed by the stubs and the finalizer)
+** -
+** `Java_obj_val` returns a new local ref
+** 		here, it is put in the `local_ref_stack`, to be deleted at the end
+** 		of the call or by `pop_local_refs`
+*/
+
+#define HANDLE_SLAB_BITS	12
+#define HANDLE_SLAB_SIZE	(1 << HANDLE_SLAB_BITS)
+#define HANDLE_SLAB_MASK	(HANDLE_SLAB_SIZE - 1)
+
+static jobjectArray *handle_slabs = NULL;
+static int handle_slab_count = 0;
+static jint *handle_next = NULL;
+static jint handle_free_list = -1;
+static jint handle_free_count = 0;
+
+static void handle_add_slab(JNIEnv *env)
+{
+	jint const		first = handle_slab_count * HANDLE_SLAB_SIZE;
+	jobjectArray	slab;
+	jint			i;
+
+	handle_slabs = realloc(handle_slabs,
+			sizeof(jobjectArray) * (handle_slab_count + 1));
+	handle_next = realloc(handle_next,
+			sizeof(jint) * (first + HANDLE_SLAB_SIZE));
+	slab = (*env)->NewObjectArray(env, HANDLE_SLAB_SIZE, CLASS(Object), NULL);
+	if (handle_slabs == NULL || handle_next == NULL || slab == NULL)
+		caml_fatal_error("ocaml-java: cannot allocate the handle table");
+	handle_slabs[handle_slab_count++] = (*env)->NewGlobalRef(env, slab);
+	(*env)->DeleteLocalRef(env, slab);
+	for (i = first; i < first + HANDLE_SLAB_SIZE - 1; i++)
+		handle_next[i] = i + 1;
+	handle_next[i] = handle_free_list;
+	handle_free_list = first;
+	handle_free_count += HANDLE_SLAB_SIZE;
+}
+
+jint ocaml_java__handle_new(JNIEnv *e, jobject obj)
+{
+	jint handle;
+
+	if (handle_free_list < 0)
+		handle_add_slab(e);
+	handle = handle_free_list;
+	handle_free_list = handle_next[handle];
+	handle_free_count--;
+	(*e)->SetObjectArrayElement(e, handle_slabs[handle >> HANDLE_SLAB_BITS],
+			handle & HANDLE_SLAB_MASK, obj);
+	return handle;
+}
+
+jobject ocaml_java__handle_get(JNIEnv *e, jint handle)
+{
+	return (*e)->GetObjectArrayElement(e,
+			handle_slabs[handle >> HANDLE_SLAB_BITS], handle & HANDLE_SLAB_MASK);
+}
+
+void ocaml_java__handle_free(JNIEnv *e, jint handle)
+{
+	(*e)->SetObjectArrayElement(e, handle_slabs[handle >> HANDLE_SLAB_BITS],
+			handle & HANDLE_SLAB_MASK, NULL);
+	handle_next[handle] = handle_free_list;
+	handle_free_list = handle;
+	handle_free_count++;
+}
+
+// Grows the table once so that `n` handles can be allocated
+static void handle_reserve(JNIEnv *e, jint n)
+{
+	while (handle_free_count < n)
+		handle_add_slab(e);
+}
+
+# undef Java_global_obj_val
+# define Java_global_obj_val(v)	(push_local_ref(ocaml_java__handle_get(	\
+		current_env_noraise(), Java_handle_val(v))))
+
+static void java_obj_finalize(value v)
+{
+	if (v != Java_null_val)
+		queue_released(Java_handle_val(v));
+}
+
+#else
+
 static void java_obj_finalize(value v)
 {
 	if (v != Java_null_val)
-		(*env)->DeleteGlobalRef(env, Java_obj_val(v));
+		queue_released(Java_global_obj_val(v));
 }
 
+# define handle_reserve(e, n)	((void)0)
+
+#endif
+
+// The functions that use `Java_obj_val` outside of a call
+// pop the local refs they may have pushed before returning or raising
+// 		down to their mark `local_refs` (see `Java_obj_val_at`)
+
 static int java_obj_compare(value a, value b)
 {
-	jobject				obj_a;
-	jobject const		obj_b = Java_obj_val_opt(b);
-	jint				d;
+	JNIEnv *const	env = current_env_noraise();
+	int const		local_refs = local_ref_count;
+	jobject			obj_a;
+	jobject const	obj_b = Java_obj_val_opt_at(b, local_refs);
+	jint			d;
 
 	if (a == Java_null_val)
+	{
+		pop_local_refs(local_refs);
 		caml_failwith("Java.compare: Null");
-	obj_a = Java_obj_val(a);
+	}
+	obj_a = Java_obj_val_at(a, local_refs);
 	if (!(*env)->IsInstanceOf(env, obj_a, CLASS(Comparable)))
+	{
+		pop_local_refs(local_refs);
 		caml_failwith("Java.compare: Must implements Comparable");
+	}
 	d = (*env)->CallIntMethod(env, obj_a, METHOD(Comparable, compareTo), obj_b);
+	pop_local_refs(local_refs);
 	check_exceptions();
 	return d;
 }
 
+// The hash is computed once, the full 32 bits are kept
 static intnat java_obj_hash(value obj)
 {
-	jobject			obj_;
-	int				hash;
+	JNIEnv *const			env = current_env_noraise();
+	int const				local_refs = local_ref_count;
+	struct java_obj_hashes	*hashes;
+	jint					hash;
 
 	if (obj == Java_null_val)
 		return 0;
-	obj_ = Java_obj_val(obj);
-	hash = (*env)->CallIntMethod(env, obj_, METHOD(Object, hashCode));
+	hashes = Java_obj_hashes(obj);
+	if (hashes->flags & JAVA_OBJ_HASHED)
+		return hashes->hash;
+	hash = (*env)->CallIntMethod(env, Java_obj_val_at(obj, local_refs),
+			METHOD(Object, hashCode));
+	pop_local_refs(local_refs);
 	check_exceptions();
-	return hash & 0x7FFFFF;
+	hashes->hash = hash;
+	hashes->flags |= JAVA_OBJ_HASHED;
+	return hash;
+}
+
+// Does not raise, local objects used outside of their frame hash to `0`
+static jint java_obj_identity_hash(value obj)
+{
+	JNIEnv *const			env = current_env_noraise();
+	int const				local_refs = local_ref_count;
+	struct java_obj_hashes	*hashes;
+	jobject					obj_;
+	jint					hash;
+
+	if (obj == Java_null_val)
+		return 0;
+	hashes = Java_obj_hashes(obj);
+	if (hashes->flags & JAVA_OBJ_IDENTITY_HASHED)
+		return hashes->identity_hash;
+	obj_ = Java_obj_get(obj);
+	if (obj_ == NULL)
+		return 0;
+	hash = (*env)->CallStaticIntMethod(env, CLASS(System),
+			STATIC_METHOD(System, identityHashCode), obj_);
+	pop_local_refs(local_refs);
+	hashes->identity_hash = hash;
+	hashes->flags |= JAVA_OBJ_IDENTITY_HASHED;
+	return hash;
 }
 
 struct custom_operations ocamljava__java_obj_custom_ops = {
@@ -100,32 +659,99 @@ struct custom_operations ocamljava__java_obj_custom_ops = {
 	.deserialize = custom_deserialize_default
 };
 
+// Local objects are not finalized, the local ref is owned by its frame
+// The same `compare` function is used to be able to compare local objects
+// 		with the other objects
+struct custom_operations ocamljava__java_local_obj_custom_ops = {
+	.identifier = "ocaml_java__local_obj",
+	.finalize = custom_finalize_default,
+	.compare = java_obj_compare,
+	.compare_ext = custom_compare_ext_default,
+	.hash = java_obj_hash,
+	.serialize = custom_serialize_default,
+	.deserialize = custom_deserialize_default
+};
+
+// Allocates a local object, `obj` is owned by the current local frame
+// If there is no local frame, allocates a normal object and deletes `obj`
+static value alloc_local_obj(jobject obj)
+{
+	JNIEnv *const	env = current_env_noraise();
+
+	value v;
+
+	if (local_frame_count == 0)
+	{
+		v = alloc_java_obj(env, obj);
+		(*env)->DeleteLocalRef(env, obj);
+		return v;
+	}
+	if ((*env)->IsSameObject(env, obj, NULL))
+		return Java_null_val;
+	v = caml_alloc_custom(&ocamljava__java_local_obj_custom_ops,
+			sizeof(struct java_local_obj), 0, 1);
+	Java_local_obj(v)->obj = obj;
+	Java_local_obj(v)->frame = local_frames[local_frame_count - 1].id;
+	Java_local_obj(v)->hashes.flags = 0;
+	return v;
+}
+
+value ocaml_java__global(value obj)
+{
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	value			v;
+
+	if (obj == Java_null_val || !Is_java_local_obj(obj))
+		return obj;
+	v = alloc_java_obj(env, Java_obj_val_at(obj, local_refs));
+	pop_local_refs(local_refs);
+	return v;
+}
+
+// `instanceof` and `sameobject` are noalloc and cannot raise
+// 		local objects used outside of their frame are not instances
+// 		of any class and are not the same object as anything
 value ocaml_java__instanceof(value obj, value cls)
 {
-	if (obj != Java_null_val
-		&& (*env)->IsInstanceOf(env, Java_obj_val(obj), Java_obj_val(cls)))
-		return Val_true;
-	return Val_false;
+	JNIEnv *const	env = current_env_noraise();
+	int const		local_refs = local_ref_count;
+	jobject			jobj;
+	jclass			jcls;
+	int				r;
+
+	jobj = (obj == Java_null_val) ? NULL : Java_obj_get(obj);
+	jcls = (jobj == NULL) ? NULL : Java_obj_get(cls);
+	r = jcls != NULL && (*env)->IsInstanceOf(env, jobj, jcls);
+	pop_local_refs(local_refs);
+	return Val_bool(r);
 }
 
 value ocaml_java__sameobject(value a, value b)
 {
-	jobject const obj_a = Java_obj_val_opt(a);
-	jobject const obj_b = Java_obj_val_opt(b);
-
-	if ((*env)->IsSameObject(env, obj_a, obj_b))
-		return Val_true;
-	return Val_false;
+	JNIEnv *const	env = current_env_noraise();
+	int const		local_refs = local_ref_count;
+	jobject const	obj_a = (a == Java_null_val) ? NULL : Java_obj_get(a);
+	jobject const	obj_b = (b == Java_null_val) ? NULL : Java_obj_get(b);
+	int const		r = (obj_a != NULL || a == Java_null_val)
+		&& (obj_b != NULL || b == Java_null_val)
+		&& (*env)->IsSameObject(env, obj_a, obj_b);
+
+	pop_local_refs(local_refs);
+	return Val_bool(r);
 }
 
 value ocaml_java__objectclass(value obj)
 {
-	jclass	cls;
-	value	v;
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jclass			cls;
+	value			v;
 
 	if (obj == Java_null_val)
 		caml_failwith("Java.objectclass: null");
-	cls = (*env)->GetObjectClass(env, Java_obj_val(obj));
+	cls = (*env)->GetObjectClass(env, Java_obj_val_at(obj, local_refs));
+	pop_local_refs(local_refs);
 	v = alloc_java_obj(env, cls);
 	(*env)->DeleteLocalRef(env, cls);
 	return v;
@@ -138,13 +764,17 @@ value ocaml_java__compare(value a, value b)
 
 value ocaml_java__to_string(value obj)
 {
-	jstring		str;
-	value		r;
+	JNIEnv *const	env = current_env();
+	jstring			str;
+	value			r;
+
+	int const	local_refs = local_ref_count;
 
 	if (obj == Java_null_val)
 		caml_failwith("Java.to_string: Null");
-	str = (*env)->CallObjectMethod(env, Java_obj_val(obj),
+	str = (*env)->CallObjectMethod(env, Java_obj_val_at(obj, local_refs),
 			METHOD(Object, toString));
+	pop_local_refs(local_refs);
 	check_exceptions();
 	r = ocaml_java__of_jstring(env, str);
 	(*env)->DeleteLocalRef(env, str);
@@ -153,12 +783,15 @@ value ocaml_java__to_string(value obj)
 
 value ocaml_java__equals(value a, value b)
 {
-	int			eq;
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	int				eq;
 
 	if (a == Java_null_val)
 		caml_failwith("Java.equals: Null");
-	eq = (*env)->CallBooleanMethod(env, Java_obj_val(a),
-			METHOD(Object, equals), Java_obj_val_opt(b));
+	eq = (*env)->CallBooleanMethod(env, Java_obj_val_at(a, local_refs),
+			METHOD(Object, equals), Java_obj_val_opt_at(b, local_refs));
+	pop_local_refs(local_refs);
 	check_exceptions();
 	return Val_long(eq);
 }
@@ -168,15 +801,24 @@ value ocaml_java__hash_code(value obj)
 	return (Val_long(java_obj_hash(obj)));
 }
 
+value ocaml_java__identity_hash(value obj)
+{
+	return (Val_long(java_obj_identity_hash(obj)));
+}
+
 /*
 ** ========================================================================== **
 ** Class
 ** -
 ** Method Ids are represented as nativeint
+** The lookups can be made while arguments are pushed,
+** 		they drop the pending call before raising `Not_found`
 */
 
 value ocaml_java__find_class(value name)
 {
+	JNIEnv *const	env = current_env();
+
 	jclass c;
 	value v;
 
@@ -184,6 +826,7 @@ value ocaml_java__find_class(value name)
 	if (c == NULL)
 	{
 		(*env)->ExceptionClear(env);
+		drop_call();
 		caml_raise_not_found();
 	}
 	v = alloc_java_obj(env, c);
@@ -193,127 +836,324 @@ value ocaml_java__find_class(value name)
 
 value ocaml_java__class_get_meth(value class_, value name, value sig)
 {
-	jmethodID id;
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jmethodID		id;
 
-	id = (*env)->GetMethodID(env, Java_obj_val(class_),
+	id = (*env)->GetMethodID(env, Java_obj_val_at(class_, local_refs),
 			String_val(name), String_val(sig));
 	if (id == NULL)
 	{
 		(*env)->ExceptionClear(env);
+		drop_call();
 		caml_raise_not_found();
 	}
+	pop_local_refs(local_refs);
 	return caml_copy_nativeint((intnat)id);
 }
 
 value ocaml_java__class_get_meth_static(value class_, value name, value sig)
 {
-	jmethodID id;
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jmethodID		id;
 
-	id = (*env)->GetStaticMethodID(env, Java_obj_val(class_),
+	id = (*env)->GetStaticMethodID(env, Java_obj_val_at(class_, local_refs),
 			String_val(name), String_val(sig));
 	if (id == NULL)
 	{
 		(*env)->ExceptionClear(env);
+		drop_call();
 		caml_raise_not_found();
 	}
+	pop_local_refs(local_refs);
 	return caml_copy_nativeint((intnat)id);
 }
 
 value ocaml_java__class_get_field(value class_, value name, value sig)
 {
-	jfieldID id;
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jfieldID		id;
 
-	id = (*env)->GetFieldID(env, Java_obj_val(class_),
+	id = (*env)->GetFieldID(env, Java_obj_val_at(class_, local_refs),
 			String_val(name), String_val(sig));
 	if (id == NULL)
 	{
 		(*env)->ExceptionClear(env);
+		drop_call();
 		caml_raise_not_found();
 	}
+	pop_local_refs(local_refs);
 	return caml_copy_nativeint((intnat)id);
 }
 
 value ocaml_java__class_get_field_static(value class_, value name, value sig)
 {
-	jfieldID id;
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jfieldID		id;
 
-	id = (*env)->GetStaticFieldID(env, Java_obj_val(class_),
+	id = (*env)->GetStaticFieldID(env, Java_obj_val_at(class_, local_refs),
 			String_val(name), String_val(sig));
 	if (id == NULL)
 	{
 		(*env)->ExceptionClear(env);
+		drop_call();
 		caml_raise_not_found();
 	}
+	pop_local_refs(local_refs);
 	return caml_copy_nativeint((intnat)id);
 }
 
+// Resolves the class and every member in `members` (see `Jclass.member`)
+// Raises `Not_found` if one of them does not exist
+value ocaml_java__class_resolve_all(value class_name, value members)
+{
+	CAMLparam2(class_name, members);
+	CAMLlocal2(res, id);
+	JNIEnv *const	env = current_env();
+	mlsize_t const	count = Wosize_val(members);
+	jclass			c;
+	void			*id_;
+	mlsize_t		i;
+
+	c = (*env)->FindClass(env, String_val(class_name));
+	if (c == NULL)
+	{
+		(*env)->ExceptionClear(env);
+		caml_raise_not_found();
+	}
+	res = caml_alloc(count + 1, 0);
+	id = alloc_java_obj(env, c);
+	Store_field(res, 0, id);
+	for (i = 0; i < count; i++)
+	{
+		value const		m = Field(members, i);
+		char const		*name = String_val(Field(m, 0));
+		char const		*sig = String_val(Field(m, 1));
+
+		switch (Tag_val(m))
+		{
+		case 0: id_ = (*env)->GetMethodID(env, c, name, sig); break;
+		case 1: id_ = (*env)->GetStaticMethodID(env, c, name, sig); break;
+		case 2: id_ = (*env)->GetFieldID(env, c, name, sig); break;
+		default: id_ = (*env)->GetStaticFieldID(env, c, name, sig); break;
+		}
+		if (id_ == NULL)
+		{
+			(*env)->ExceptionClear(env);
+			(*env)->DeleteLocalRef(env, c);
+			caml_raise_not_found();
+		}
+		id = caml_copy_nativeint((intnat)id_);
+		Store_field(res, i + 1, id);
+	}
+	(*env)->DeleteLocalRef(env, c);
+	CAMLreturn(res);
+}
+
 /*
 ** ========================================================================== **
 ** Init
 */
 
+static void init_attached_key(void)
+{
+	pthread_key_create(&attached_key, detach_thread);
+}
+
 JNIEnv	*ocaml_java__camljava_env(void)
 {
-	return env;
+	return main_env;
+}
+
+// Set by the `call_blocking_*` functions while the runtime lock is released
+static __thread int in_blocking_call = 0;
+
+int		ocaml_java__in_blocking_call(void)
+{
+	return in_blocking_call;
+}
+
+JNIEnv	*ocaml_java__env(void)
+{
+	return current_env();
+}
+
+JNIEnv	*ocaml_java__env_noraise(void)
+{
+	return current_env_noraise();
 }
 
 void	ocaml_java__camljava_setenv(JNIEnv *e)
 {
-	env = e;
+	static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&key_once, init_attached_key);
+	(*e)->GetJavaVM(e, &jvm);
+	main_env = e;
+	thread_env = e;
 }
 
 /*
 ** ========================================================================== **
-** Calling
+** String intern cache
 ** -
-** `arg_stack` represents the argument stack
-** `local_ref_stack` stores references to objects allocated in `arg_` functions
-** `local_ref_cleared` is set to true before calling a method
-** 		so that the next call to `push_local_ref` assumes the stack is empty
+** Two direct-mapped tables of `intern_size` entries (a power of 2),
+** 		the cache is disabled if `intern_size` is 0
+** `intern_to` maps the content of an OCaml string to a global ref
+** 		to an equal Java String, the content is copied
+** `intern_of` maps a Java String, by identity, to an OCaml string,
+** 		stored in a generational global root
+** A new entry replaces the entry in its slot
+** The tables are shared by all threads, they are protected by the runtime lock
 */
 
-#define ARG_STACK_MAX_SIZE	16
-#define LOCALREF_STACK_MAX_SIZE	32
+struct intern_to_entry
+{
+	char		*str;
+	mlsize_t	length;
+	jobject		jstr;
+};
 
-static jvalue arg_stack[ARG_STACK_MAX_SIZE];
-static int arg_count = 0;
+struct intern_of_entry
+{
+	jobject		jstr;
+	value		str;
+};
 
-// // Local refs
+static uintnat					intern_size = 0;
+static struct intern_to_entry	*intern_to = NULL;
+static struct intern_of_entry	*intern_of = NULL;
 
-static jobject local_ref_stack[LOCALREF_STACK_MAX_SIZE];
-static int local_ref_count = 0;
-static int local_ref_cleared = 0;
+// Hits and misses of `intern_to` then `intern_of`
+static intnat					intern_stats[4] = { 0, 0, 0, 0 };
 
-// Clear the local_ref_stack
-// Should be called after calls
-static void clear_local_refs(void)
+// FNV-1a
+static uintnat	intern_hash(char const *str, mlsize_t length)
 {
-	int i;
+	uint32_t	h;
+	mlsize_t	i;
 
-	for (i = 0; i < local_ref_count; i++)
-		(*env)->DeleteLocalRef(env, local_ref_stack[i]);
-	local_ref_count = 0;
-	local_ref_cleared = 0;
+	h = 2166136261u;
+	for (i = 0; i < length; i++)
+		h = (h ^ (uint8_t)str[i]) * 16777619u;
+	return h;
 }
 
-// Adds a local ref onto the stack
-static void push_local_ref(jobject obj)
+static void		intern_free(void)
 {
-	if (local_ref_cleared)
+	JNIEnv *const	env = current_env_noraise();
+	uintnat			i;
+
+	for (i = 0; i < intern_size; i++)
 	{
-		local_ref_count = 0;
-		local_ref_cleared = 0;
+		if (intern_to[i].jstr != NULL)
+			(*env)->DeleteGlobalRef(env, intern_to[i].jstr);
+		free(intern_to[i].str);
+		if (intern_of[i].jstr != NULL)
+			(*env)->DeleteGlobalRef(env, intern_of[i].jstr);
+		caml_remove_generational_global_root(&intern_of[i].str);
 	}
-	local_ref_stack[local_ref_count] = obj;
-	local_ref_count++;
+	free(intern_to);
+	free(intern_of);
+	intern_to = NULL;
+	intern_of = NULL;
+	intern_size = 0;
 }
 
-// Must be called before calling a java method
-// Reset the arg_stack and mark the local_ref_stack to be cleared later
-static void begin_call(void)
+// Returns a local ref or `NULL` if `v` is not in the cache
+static jstring	intern_to_find(value v, struct intern_to_entry **slot)
+{
+	JNIEnv *const			env = current_env_noraise();
+	mlsize_t const			length = caml_string_length(v);
+	struct intern_to_entry	*e;
+
+	e = &intern_to[intern_hash(String_val(v), length) & (intern_size - 1)];
+	*slot = e;
+	if (e->jstr == NULL || e->length != length
+		|| memcmp(e->str, String_val(v), length) != 0)
+	{
+		intern_stats[1]++;
+		return NULL;
+	}
+	intern_stats[0]++;
+	return (*env)->NewLocalRef(env, e->jstr);
+}
+
+// The entry is not replaced if the copy cannot be allocated
+static void		intern_to_add(struct intern_to_entry *e, value v, jstring js)
+{
+	JNIEnv *const	env = current_env_noraise();
+	mlsize_t const	length = caml_string_length(v);
+	char *const		str = malloc(length + 1);
+
+	if (str == NULL)
+		return ;
+	memcpy(str, String_val(v), length);
+	if (e->jstr != NULL)
+		(*env)->DeleteGlobalRef(env, e->jstr);
+	free(e->str);
+	e->str = str;
+	e->length = length;
+	e->jstr = (*env)->NewGlobalRef(env, js);
+}
+
+value ocaml_java__intern_set_size(value size)
+{
+	uintnat		n;
+	uintnat		i;
+
+	if (Long_val(size) < 0)
+		caml_invalid_argument("Java.Intern.set_size");
+	intern_free();
+	if (Long_val(size) == 0)
+		return Val_unit;
+	for (n = 1; n < (uintnat)Long_val(size); n <<= 1)
+		;
+	intern_to = calloc(n, sizeof(struct intern_to_entry));
+	intern_of = calloc(n, sizeof(struct intern_of_entry));
+	if (intern_to == NULL || intern_of == NULL)
+	{
+		free(intern_to);
+		free(intern_of);
+		intern_to = NULL;
+		intern_of = NULL;
+		caml_raise_out_of_memory();
+	}
+	for (i = 0; i < n; i++)
+	{
+		intern_of[i].str = Val_unit;
+		caml_register_generational_global_root(&intern_of[i].str);
+	}
+	intern_size = n;
+	return Val_unit;
+}
+
+value ocaml_java__intern_size(value unit)
+{
+	return Val_long(intern_size);
+	(void)unit;
+}
+
+value ocaml_java__intern_stats(value unit)
+{
+	value		v;
+	int			i;
+
+	v = caml_alloc_tuple(4);
+	for (i = 0; i < 4; i++)
+		Store_field(v, i, Val_long(intern_stats[i]));
+	return v;
+	(void)unit;
+}
+
+value ocaml_java__intern_reset_stats(value unit)
 {
-	local_ref_cleared = 1;
-	arg_count = 0;
+	memset(intern_stats, 0, sizeof(intern_stats));
+	return Val_unit;
+	(void)unit;
 }
 
 /*
@@ -326,6 +1166,8 @@ static void begin_call(void)
 
 static value conv_of_string(jstring str)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	value v;
 
 	if (IS_NULL(env, str)) caml_failwith("Null string");
@@ -336,6 +1178,8 @@ static value conv_of_string(jstring str)
 
 static value conv_of_value(jobject v)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	value jvalue;
 
 	if (IS_NULL(env, v)) caml_failwith("Null value");
@@ -346,6 +1190,8 @@ static value conv_of_value(jobject v)
 
 static value conv_of_array(jarray a)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	value v;
 
 	if (IS_NULL(env, a)) caml_failwith("Null array");
@@ -358,6 +1204,8 @@ static value conv_of_string_opt(jstring str)
 {
 	CAMLparam0();
 	CAMLlocal1(cstr);
+	JNIEnv *const	env = current_env_noraise();
+
 	if (IS_NULL(env, str)) CAMLreturn(Val_none);
 	cstr = ocaml_java__of_jstring(env, str);
 	(*env)->DeleteLocalRef(env, str);
@@ -368,6 +1216,8 @@ static value conv_of_value_opt(jobject v)
 {
 	CAMLparam0();
 	CAMLlocal1(jvalue);
+	JNIEnv *const	env = current_env_noraise();
+
 	if (IS_NULL(env, v)) CAMLreturn(Val_none);
 	jvalue = JVALUE_GET(env, v);
 	(*env)->DeleteLocalRef(env, v);
@@ -378,6 +1228,8 @@ static value conv_of_array_opt(jarray a)
 {
 	CAMLparam0();
 	CAMLlocal1(v);
+	JNIEnv *const	env = current_env_noraise();
+
 	if (IS_NULL(env, a)) CAMLreturn(Val_none);
 	v = alloc_java_obj(env, a);
 	(*env)->DeleteLocalRef(env, a);
@@ -386,6 +1238,8 @@ static value conv_of_array_opt(jarray a)
 
 static value conv_of_obj(jobject obj)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	value v;
 
 	v = alloc_java_obj(env, obj);
@@ -395,6 +1249,8 @@ static value conv_of_obj(jobject obj)
 
 static jobject conv_to_string(value v)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	jstring const js = ocaml_java__to_jstring(env, v);
 
 	push_local_ref(js);
@@ -410,6 +1266,8 @@ static jobject conv_to_string_opt(value opt)
 
 static jobject conv_to_value(value v)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	jobject const obj = JVALUE_NEW(env, v);
 
 	push_local_ref(obj);
@@ -423,11 +1281,57 @@ static jobject conv_to_value_opt(value opt)
 	return conv_to_value(Some_val(opt));
 }
 
-static jarray conv_to_array_opt(value opt)
+// The objects are converted with the mark `local_refs` of the caller
+// 		`-1` in the `push_` functions, the call is dropped (see `drop_call`)
+#define conv_to_obj(v)		Java_obj_val_opt_at(v, local_refs)
+#define conv_to_array(v)	Java_obj_val_at(v, local_refs)
+#define conv_to_array_opt(opt)	(((opt) == Val_none) ? NULL \
+		: Java_obj_val_at(Some_val(opt), local_refs))
+
+// Interned strings, see the intern cache above
+static value conv_of_string_interned(jstring str)
 {
-	if (opt == Val_none)
-		return NULL;
-	return Java_obj_val(Some_val(opt));
+	JNIEnv *const			env = current_env_noraise();
+	struct intern_of_entry	*e;
+	value					v;
+
+	if (intern_size == 0)
+		return conv_of_string(str);
+	if (IS_NULL(env, str)) caml_failwith("Null string");
+	e = &intern_of[(uint32_t)(*env)->CallStaticIntMethod(env, CLASS(System),
+			STATIC_METHOD(System, identityHashCode), str) & (intern_size - 1)];
+	if (e->jstr != NULL && (*env)->IsSameObject(env, e->jstr, str))
+	{
+		intern_stats[2]++;
+		(*env)->DeleteLocalRef(env, str);
+		return e->str;
+	}
+	intern_stats[3]++;
+	v = ocaml_java__of_jstring(env, str);
+	if (e->jstr != NULL)
+		(*env)->DeleteGlobalRef(env, e->jstr);
+	e->jstr = (*env)->NewGlobalRef(env, str);
+	caml_modify_generational_global_root(&e->str, v);
+	(*env)->DeleteLocalRef(env, str);
+	return v;
+}
+
+static jobject conv_to_string_interned(value v)
+{
+	JNIEnv *const			env = current_env_noraise();
+	struct intern_to_entry	*e;
+	jstring					js;
+
+	if (intern_size == 0)
+		return conv_to_string(v);
+	js = intern_to_find(v, &e);
+	if (js == NULL)
+	{
+		js = ocaml_java__to_jstring(env, v);
+		intern_to_add(e, v, js);
+	}
+	push_local_ref(js);
+	return js;
 }
 
 // Calls `GEN` for each primitive types:
@@ -439,14 +1343,18 @@ static jarray conv_to_array_opt(value opt)
 //  CONV_OF	`TYPE` to OCaml's `value` convertion
 //  DST		field of the `jvalue` union
 //  CONV_TO	OCaml's `value` to `TYPE` convertion
-#define GEN_PRIM_INT(GEN) \
+#define GEN_PRIM_TAGGED(GEN) \
 	GEN(int,		Int,		jint,		Val_long,			i,	Long_val) \
 	GEN(bool,		Boolean,	jboolean,	Val_bool,			z,	Long_val) \
 	GEN(byte,		Byte,		jbyte,		Val_long,			b,	Long_val) \
 	GEN(short,		Short,		jshort,		Val_long,			s,	Long_val) \
-	GEN(char,		Char,		jchar,		Val_long,			c,	Long_val) \
+	GEN(char,		Char,		jchar,		Val_long,			c,	Long_val)
+#define GEN_PRIM_BOXED(GEN) \
 	GEN(int32,		Int,		jint,		caml_copy_int32,	i,	Int32_val) \
 	GEN(long,		Long,		jlong,		caml_copy_int64,	j,	Int64_val)
+#define GEN_PRIM_INT(GEN) \
+	GEN_PRIM_TAGGED(GEN) \
+	GEN_PRIM_BOXED(GEN)
 #define GEN_PRIM_FLOAT(GEN) \
 	GEN(float,		Float,		jfloat,		caml_copy_double,	f,	Double_val) \
 	GEN(double,		Double,		jdouble,	caml_copy_double,	d,	Double_val)
@@ -455,172 +1363,530 @@ static jarray conv_to_array_opt(value opt)
 	GEN_PRIM_INT(GEN) \
 	GEN_PRIM_FLOAT(GEN)
 
+// Same as `GEN_PRIM` for the types that have an unboxed representation
+// with params:
+//  NAME, JNAME, TYPE and DST	same as `GEN_PRIM`
+//  UTYPE	the unboxed (or untagged) type
+#define GEN_PRIM_UNBOXED(GEN) \
+	GEN(int,		Int,		jint,		intnat,		i) \
+	GEN(byte,		Byte,		jbyte,		intnat,		b) \
+	GEN(short,		Short,		jshort,		intnat,		s) \
+	GEN(int32,		Int,		jint,		int32_t,	i) \
+	GEN(long,		Long,		jlong,		int64_t,	j) \
+	GEN(float,		Float,		jfloat,		double,		f) \
+	GEN(double,		Double,		jdouble,	double,		d)
+
+// The Bigarray kind with the same representation as the Java type
+// with params:
+//  NAME, JNAME and TYPE	same as `GEN_PRIM`
+//  KIND	the Bigarray kind
+#define GEN_PRIM_BIGARRAY(GEN) \
+	GEN(int,		Int,		jint,		CAML_BA_INT32) \
+	GEN(bool,		Boolean,	jboolean,	CAML_BA_UINT8) \
+	GEN(byte,		Byte,		jbyte,		CAML_BA_SINT8) \
+	GEN(short,		Short,		jshort,		CAML_BA_SINT16) \
+	GEN(char,		Char,		jchar,		CAML_BA_UINT16) \
+	GEN(int32,		Int,		jint,		CAML_BA_INT32) \
+	GEN(long,		Long,		jlong,		CAML_BA_INT64) \
+	GEN(float,		Float,		jfloat,		CAML_BA_FLOAT32) \
+	GEN(double,		Double,		jdouble,	CAML_BA_FLOAT64)
+
 // Same as `GEN_PRIM` for object types:
 //  string, stringopt, object, value, valueopt
 #define GEN_OBJ(GEN) \
 	GEN(string,		Object,		jobject,	conv_of_string,		l,	conv_to_string) \
 	GEN(string_opt,	Object,		jobject,	conv_of_string_opt,	l,	conv_to_string_opt) \
-	GEN(object,		Object,		jobject,	conv_of_obj,		l,	Java_obj_val_opt) \
+	GEN(object,		Object,		jobject,	conv_of_obj,		l,	conv_to_obj) \
 	GEN(value,		Object,		jobject,	conv_of_value,		l,	conv_to_value) \
 	GEN(value_opt,	Object,		jobject,	conv_of_value_opt,	l,	conv_to_value_opt) \
-	GEN(array,		Object,		jarray,		conv_of_array,		l,	Java_obj_val) \
+	GEN(array,		Object,		jarray,		conv_of_array,		l,	conv_to_array) \
 	GEN(array_opt,	Object,		jarray,		conv_of_array_opt,	l,	conv_to_array_opt)
 
+// Same as `GEN_OBJ` for the strings that go through the intern cache,
+//  only the calls, fields and pushs are generated
+#define GEN_INTERNED(GEN) \
+	GEN(string_interned,	Object,	jobject,	conv_of_string_interned,	l, \
+		conv_to_string_interned)
+
 // `GEN_PRIM` and `GEN_OBJ`
 #define GEN(GEN) \
 	GEN_PRIM(GEN) \
 	GEN_OBJ(GEN)
 
+/*
+** ========================================================================== **
+** Stubs API
+** -
+** See `ocamljava_stubs.h`
+*/
+
+int		ocaml_java__stub_enter(void)
+{
+	return local_ref_count;
+}
+
+void	ocaml_java__stub_leave(int mark)
+{
+	pop_local_refs(mark);
+	check_exceptions();
+}
+
+void	ocaml_java__stub_null(void)
+{
+	caml_failwith("Jcall.call: null");
+}
+
+jobject	ocaml_java__stub_obj(JNIEnv *env, value v, int mark)
+{
+	return Java_obj_val_opt_at(v, mark);
+}
+
+jstring	ocaml_java__stub_string(JNIEnv *e, value v)
+{
+	return conv_to_string(v);
+	(void)e;
+}
+
+value	ocaml_java__stub_of_obj(JNIEnv *e, jobject obj)
+{
+	return conv_of_obj(obj);
+	(void)e;
+}
+
+value	ocaml_java__stub_of_string(JNIEnv *e, jstring str)
+{
+	return conv_of_string(str);
+	(void)e;
+}
+
+static void stub_not_found(char const *what, char const *name, char const *sig)
+{
+	char	msg[256];
+
+	snprintf(msg, sizeof(msg), "Java stubs: %s not found: %s %s",
+			what, name, sig);
+	caml_failwith(msg);
+}
+
+jclass	ocaml_java__stub_class(JNIEnv *e, char const *name)
+{
+	jclass	c;
+	jclass	global;
+
+	c = (*e)->FindClass(e, name);
+	if (c == NULL)
+	{
+		(*e)->ExceptionClear(e);
+		stub_not_found("class", name, "");
+	}
+	global = (*e)->NewGlobalRef(e, c);
+	(*e)->DeleteLocalRef(e, c);
+	return global;
+}
+
+jmethodID	ocaml_java__stub_method(JNIEnv *e, jclass cls,
+				char const *name, char const *sig, int is_static)
+{
+	jmethodID	id;
+
+	id = is_static ? (*e)->GetStaticMethodID(e, cls, name, sig)
+		: (*e)->GetMethodID(e, cls, name, sig);
+	if (id == NULL)
+	{
+		(*e)->ExceptionClear(e);
+		stub_not_found("method", name, sig);
+	}
+	return id;
+}
+
+jfieldID	ocaml_java__stub_field(JNIEnv *e, jclass cls,
+				char const *name, char const *sig, int is_static)
+{
+	jfieldID	id;
+
+	id = is_static ? (*e)->GetStaticFieldID(e, cls, name, sig)
+		: (*e)->GetFieldID(e, cls, name, sig);
+	if (id == NULL)
+	{
+		(*e)->ExceptionClear(e);
+		stub_not_found("field", name, sig);
+	}
+	return id;
+}
+
 /*
 ** ========================================================================== **
 ** Call API
 */
 
-value ocaml_java__new(value cls, value meth)
-{
-	jclass		jcls;
-	jmethodID	jmeth;
-	jobject		obj;
-	value		v;
+value ocaml_java__new(value cls, value meth)
+{
+	JNIEnv *const		env = current_env();
+	struct call_frame	frame;
+	jclass				jcls;
+	jmethodID			jmeth;
+	jobject				obj;
+	value				v;
+
+	jcls = Java_obj_val(cls);
+	jmeth = (jmethodID)Nativeint_val(meth);
+	obj = (*env)->NewObjectA(env, jcls, jmeth, begin_call(&frame));
+	end_call(&frame);
+	if (obj == NULL)
+	{
+		check_exceptions();
+		caml_failwith("Jcall.new_: Allocation failed");
+	}
+	v = alloc_java_obj(env, obj);
+	(*env)->DeleteLocalRef(env, obj);
+	return v;
+}
+
+// Generates call{,_static,_nonvirtual}_* functions
+// `CONV_OF` is a function that convert a native type to OCaml's value
+// `RTYPE` is the return type, `value` or the unboxed type
+// The objects are converted before `begin_call` because it may raise
+//  (see `Java_obj_val`), the local refs it creates are popped by `end_call`
+#define GEN_CALL_(NAME, JNAME, RTYPE, RESULT, CONV_OF) \
+RTYPE ocaml_java__call_##NAME(value obj, value meth)						\
+{																			\
+	JNIEnv *const		env = current_env();								\
+	struct call_frame	frame;												\
+	jobject				jobj;												\
+	jvalue				*args;												\
+																			\
+	if (obj == Java_null_val)												\
+	{																		\
+		drop_call();														\
+		caml_failwith("Jcall.call: null");									\
+	}																		\
+	jobj = Java_obj_val(obj);												\
+	args = begin_call(&frame);												\
+	RESULT (*env)->Call##JNAME##MethodA(env,								\
+		jobj,																\
+		(jmethodID)Nativeint_val(meth),										\
+		args);																\
+	end_call(&frame);														\
+	check_exceptions();														\
+	return CONV_OF;															\
+}																			\
+RTYPE ocaml_java__call_static_##NAME(value cls, value meth)					\
+{																			\
+	JNIEnv *const		env = current_env();								\
+	struct call_frame	frame;												\
+	jclass const		jcls = Java_obj_val(cls);							\
+	jvalue *const		args = begin_call(&frame);							\
+																			\
+	RESULT (*env)->CallStatic##JNAME##MethodA(env,							\
+		jcls,																\
+		(jmethodID)Nativeint_val(meth),										\
+		args);																\
+	end_call(&frame);														\
+	check_exceptions();														\
+	return CONV_OF;															\
+}																			\
+RTYPE ocaml_java__call_nonvirtual_##NAME(value obj,							\
+	value cls, value meth)													\
+{																			\
+	JNIEnv *const		env = current_env();								\
+	struct call_frame	frame;												\
+	jobject				jobj;												\
+	jclass				jcls;												\
+	jvalue				*args;												\
+																			\
+	if (obj == Java_null_val)												\
+	{																		\
+		drop_call();														\
+		caml_failwith("Jcall.call_nonvirtual: null");						\
+	}																		\
+	jobj = Java_obj_val(obj);												\
+	jcls = Java_obj_val(cls);												\
+	args = begin_call(&frame);												\
+	RESULT (*env)->CallNonvirtual##JNAME##MethodA(env,						\
+		jobj,																\
+		jcls,																\
+		(jmethodID)Nativeint_val(meth),										\
+		args);																\
+	end_call(&frame);														\
+	check_exceptions();														\
+	return CONV_OF;															\
+}
+
+#define GEN_CALL(NAME, JNAME, TYPE, CONV_OF) \
+	GEN_CALL_(NAME, JNAME, value, TYPE res =, CONV_OF(res))
+
+// Generates call_blocking_* and call_static_blocking_* functions
+// Same as `GEN_CALL_` but the OCaml runtime is released during the Java call
+// `in_blocking_call` is set meanwhile, calls back into OCaml throw
+//  a ThreadException (see `caml.c`)
+// The arguments on the stack do not point to the OCaml heap
+// `obj`, `cls` and the object arguments are resolved to new local refs
+//  before the runtime is released (see `resolve_obj_args`)
+#define GEN_CALL_BLOCKING_(NAME, JNAME, RTYPE, RESULT, CONV_OF) \
+RTYPE ocaml_java__call_blocking_##NAME(value obj, value meth)				\
+{																			\
+	CAMLparam2(obj, meth);													\
+	JNIEnv *const		env = current_env();								\
+	struct call_frame	frame;												\
+	jvalue				*args;												\
+	jobject				jobj;												\
+	jmethodID			jmeth;												\
+																			\
+	if (obj == Java_null_val)												\
+	{																		\
+		drop_call();														\
+		caml_failwith("Jcall.call_blocking: null");							\
+	}																		\
+	jobj = push_local_ref((*env)->NewLocalRef(env, Java_obj_val(obj)));		\
+	jmeth = (jmethodID)Nativeint_val(meth);									\
+	resolve_obj_args(env);													\
+	args = begin_call(&frame);												\
+	in_blocking_call = 1;													\
+	caml_release_runtime_system();											\
+	RESULT (*env)->Call##JNAME##MethodA(env, jobj, jmeth, args);			\
+	caml_acquire_runtime_system();											\
+	in_blocking_call = 0;													\
+	end_call(&frame);														\
+	check_exceptions();														\
+	CAMLreturnT(RTYPE, CONV_OF);											\
+}																			\
+RTYPE ocaml_java__call_static_blocking_##NAME(value cls, value meth)		\
+{																			\
+	CAMLparam2(cls, meth);													\
+	JNIEnv *const		env = current_env();								\
+	jmethodID const		jmeth = (jmethodID)Nativeint_val(meth);				\
+	struct call_frame	frame;												\
+	jclass				jcls;												\
+	jvalue				*args;												\
+																			\
+	jcls = push_local_ref((*env)->NewLocalRef(env, Java_obj_val(cls)));		\
+	resolve_obj_args(env);													\
+	args = begin_call(&frame);												\
+	in_blocking_call = 1;													\
+	caml_release_runtime_system();											\
+	RESULT (*env)->CallStatic##JNAME##MethodA(env, jcls, jmeth, args);		\
+	caml_acquire_runtime_system();											\
+	in_blocking_call = 0;													\
+	end_call(&frame);														\
+	check_exceptions();														\
+	CAMLreturnT(RTYPE, CONV_OF);											\
+}
+
+#define GEN_CALL_BLOCKING(NAME, JNAME, TYPE, CONV_OF, ...) \
+	GEN_CALL_BLOCKING_(NAME, JNAME, value, TYPE res =, CONV_OF(res))
 
-	jcls = Java_obj_val(cls);
-	jmeth = (jmethodID)Nativeint_val(meth);
-	begin_call();
-	obj = (*env)->NewObjectA(env, jcls, jmeth, arg_stack);
-	clear_local_refs();
-	if (obj == NULL)
-	{
-		check_exceptions();
-		caml_failwith("Jcall.new_: Allocation failed");
-	}
-	v = alloc_java_obj(env, obj);
-	(*env)->DeleteLocalRef(env, obj);
-	return v;
-}
+// Generates the fused call_*_* and call_static_*_* functions
+// The arguments are passed directly and stored in a `jvalue` array
+//  on the C stack, without using `arg_stack`
+// `A` and `B` are the argument codes:
+//  i	int
+//  o	object, may be null
+#define FUSED_ARG_i(DST, V)	((DST).i = Long_val(V))
+#define FUSED_ARG_o(DST, V)	((DST).l = Java_obj_val_opt(V))
 
-// Generates call{,_static,_nonvirtual}_* functions
-// `CONV_OF` is a function that convert a native type to OCaml's value
-#define GEN_CALL_(NAME, JNAME, RESULT, CONV_OF) \
-value ocaml_java__call_##NAME(value obj, value meth)						\
+#define GEN_CALL_FUSED_(NAME, JNAME, RESULT, CONV_OF, CODES, N, FILL, ...) \
+value ocaml_java__call_##NAME##_##CODES(value obj, value meth, __VA_ARGS__)	\
 {																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jvalue			args[N];												\
+																			\
 	if (obj == Java_null_val)												\
 		caml_failwith("Jcall.call: null");									\
-	begin_call();															\
+	FILL;																	\
 	RESULT (*env)->Call##JNAME##MethodA(env,								\
 		Java_obj_val(obj),													\
 		(jmethodID)Nativeint_val(meth),										\
-		arg_stack);															\
-	clear_local_refs();														\
+		args);																\
+	pop_local_refs(local_refs);												\
 	check_exceptions();														\
 	return CONV_OF;															\
 }																			\
-value ocaml_java__call_static_##NAME(value cls, value meth)					\
+value ocaml_java__call_static_##NAME##_##CODES(value cls, value meth,		\
+	__VA_ARGS__)															\
 {																			\
-	begin_call();															\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jvalue			args[N];												\
+																			\
+	FILL;																	\
 	RESULT (*env)->CallStatic##JNAME##MethodA(env,							\
 		Java_obj_val(cls),													\
 		(jmethodID)Nativeint_val(meth),										\
-		arg_stack);															\
-	clear_local_refs();														\
-	check_exceptions();														\
-	return CONV_OF;															\
-}																			\
-value ocaml_java__call_nonvirtual_##NAME(value obj,							\
-	value cls, value meth)													\
-{																			\
-	if (obj == Java_null_val)												\
-		caml_failwith("Jcall.call_nonvirtual: null");						\
-	begin_call();															\
-	RESULT (*env)->CallNonvirtual##JNAME##MethodA(env,						\
-		Java_obj_val(obj),													\
-		Java_obj_val(cls),													\
-		(jmethodID)Nativeint_val(meth),										\
-		arg_stack);															\
-	clear_local_refs();														\
+		args);																\
+	pop_local_refs(local_refs);												\
 	check_exceptions();														\
 	return CONV_OF;															\
 }
 
-#define GEN_CALL(NAME, JNAME, TYPE, CONV_OF) \
-	GEN_CALL_(NAME, JNAME, TYPE res =, CONV_OF(res))
+#define GEN_CALL_FUSED_1(NAME, JNAME, RESULT, CONV_OF, A) \
+	GEN_CALL_FUSED_(NAME, JNAME, RESULT, CONV_OF, A, 1,					\
+		FUSED_ARG_##A(args[0], a),											\
+		value a)
+
+#define GEN_CALL_FUSED_2(NAME, JNAME, RESULT, CONV_OF, A, B) \
+	GEN_CALL_FUSED_(NAME, JNAME, RESULT, CONV_OF, A##B, 2,				\
+		(FUSED_ARG_##A(args[0], a), FUSED_ARG_##B(args[1], b)),				\
+		value a, value b)
+
+// Calls `GEN` for each return type of the fused calls
+//  with the argument codes as extra params
+#define GEN_FUSED_RET(GEN, ...) \
+	GEN(void,	Void,		(void),			Val_unit,				__VA_ARGS__) \
+	GEN(int,	Int,		jint res =,		Val_long(res),			__VA_ARGS__) \
+	GEN(bool,	Boolean,	jboolean res =,	Val_bool(res),			__VA_ARGS__) \
+	GEN(object,	Object,		jobject res =,	conv_of_obj(res),		__VA_ARGS__) \
+	GEN(string,	Object,		jobject res =,	conv_of_string(res),	__VA_ARGS__)
 
 // Generates read_field{,_static}_* functions
-#define GEN_READ(NAME, JNAME, CONV_OF) \
-value ocaml_java__read_field_##NAME(value obj, value field)					\
+// `TYPE` is the jni type of the field
+#define GEN_READ_(NAME, JNAME, TYPE, RTYPE, CONV_OF) \
+RTYPE ocaml_java__read_field_##NAME(value obj, value field)					\
 {																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	TYPE			res;													\
+																			\
 	if (obj == Java_null_val)												\
 		caml_failwith("Jcall.read_field: null");							\
-	return CONV_OF((*env)->Get##JNAME##Field(env,							\
-			Java_obj_val(obj),												\
-			(jfieldID)Nativeint_val(field)));								\
+	res = (*env)->Get##JNAME##Field(env,									\
+			Java_obj_val_at(obj, local_refs),								\
+			(jfieldID)Nativeint_val(field));								\
+	pop_local_refs(local_refs);												\
+	return CONV_OF(res);													\
 }																			\
-value ocaml_java__read_field_static_##NAME(value cls, value field)			\
+RTYPE ocaml_java__read_field_static_##NAME(value cls, value field)			\
 {																			\
-	return CONV_OF((*env)->GetStatic##JNAME##Field(env,						\
-			Java_obj_val(cls),												\
-			(jfieldID)Nativeint_val(field)));								\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	TYPE			res;													\
+																			\
+	res = (*env)->GetStatic##JNAME##Field(env,								\
+			Java_obj_val_at(cls, local_refs),								\
+			(jfieldID)Nativeint_val(field));								\
+	pop_local_refs(local_refs);												\
+	return CONV_OF(res);													\
 }
 
+#define GEN_READ(NAME, JNAME, TYPE, CONV_OF) \
+	GEN_READ_(NAME, JNAME, TYPE, value, CONV_OF)
+
+// Whether a jvalue's field is an object, see `push_arg`
+#define ARG_IS_OBJ_z	0
+#define ARG_IS_OBJ_b	0
+#define ARG_IS_OBJ_c	0
+#define ARG_IS_OBJ_s	0
+#define ARG_IS_OBJ_i	0
+#define ARG_IS_OBJ_j	0
+#define ARG_IS_OBJ_f	0
+#define ARG_IS_OBJ_d	0
+#define ARG_IS_OBJ_l	1
+
 // Generates push_* functions
 // `CONV_TO` is a function that takes an OCaml value and generates a native type
 // `DST` is the jvalue's field
 #define GEN_PUSH(NAME, JNAME, DST, CONV_TO) \
 value ocaml_java__push_##NAME(value v)			\
 {												\
-	arg_stack[arg_count].DST = CONV_TO(v);		\
-	arg_count++;								\
+	int const	local_refs = -1;				\
+	jvalue		arg;							\
+												\
+	arg.DST = CONV_TO(v);						\
+	*push_arg(ARG_IS_OBJ_##DST) = arg;			\
 	return Val_unit;							\
 }
 
 #define GEN_PUSH_UNBOXED(NAME, TYPE, DST) \
 value ocaml_java__push_##NAME##_unboxed(TYPE v)		\
 {													\
-	arg_stack[arg_count].DST = v;					\
-	arg_count++;									\
+	push_arg(ARG_IS_OBJ_##DST)->DST = v;			\
 	return Val_unit;								\
 }
 
 // Generates write_field{,_static}_* functions
-#define GEN_WRITE(NAME, JNAME, DST, CONV_TO) \
-value ocaml_java__write_field_##NAME(value obj, value field, value v)			\
+// `VTYPE` is the type of the new value, `value` or the unboxed type
+#define GEN_WRITE_(NAME, JNAME, VTYPE, CONV_TO) \
+value ocaml_java__write_field_##NAME(value obj, value field, VTYPE v)			\
 {																				\
+	JNIEnv *const	env = current_env();										\
+	int const		local_refs = local_ref_count;								\
+																				\
 	if (obj == Java_null_val)													\
 		caml_failwith("Jcall.write_field: null");								\
 	(*env)->Set##JNAME##Field(env,												\
-		Java_obj_val(obj),														\
+		Java_obj_val_at(obj, local_refs),										\
 		(jfieldID)Nativeint_val(field),											\
 		CONV_TO(v));															\
-	clear_local_refs();															\
+	pop_local_refs(local_refs);													\
 	return Val_unit;															\
 }																				\
 value ocaml_java__write_field_static_##NAME(value cls,					\
-	value field, value v)														\
+	value field, VTYPE v)														\
 {																				\
+	JNIEnv *const	env = current_env();										\
+	int const		local_refs = local_ref_count;								\
+																				\
 	(*env)->SetStatic##JNAME##Field(env,										\
-		Java_obj_val(cls),														\
+		Java_obj_val_at(cls, local_refs),										\
 		(jfieldID)Nativeint_val(field),											\
 		CONV_TO(v));															\
-	clear_local_refs();															\
+	pop_local_refs(local_refs);													\
 	return Val_unit;															\
 }
 
+#define GEN_WRITE(NAME, JNAME, DST, CONV_TO) \
+	GEN_WRITE_(NAME, JNAME, value, CONV_TO)
+
 #define GEN_CALL_READ_PUSH_WRITE(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
 	GEN_CALL(NAME, JNAME, TYPE, CONV_OF) \
-	GEN_READ(NAME, JNAME, CONV_OF) \
+	GEN_READ(NAME, JNAME, TYPE, CONV_OF) \
 	GEN_PUSH(NAME, JNAME, DST, CONV_TO) \
 	GEN_WRITE(NAME, JNAME, DST, CONV_TO)
 
+// Generates the native entry points of the [@unboxed] and [@untagged]
+//  externals, the bytecode versions are generated by `GEN_PRIM`
+// `UTYPE` is the unboxed type
+#define GEN_UNBOXED(NAME, JNAME, TYPE, UTYPE, DST) \
+	GEN_CALL_(NAME##_unboxed, JNAME, UTYPE, TYPE res =, (UTYPE)res) \
+	GEN_CALL_BLOCKING_(NAME##_unboxed, JNAME, UTYPE, TYPE res =, (UTYPE)res) \
+	GEN_READ_(NAME##_unboxed, JNAME, TYPE, UTYPE, (UTYPE)) \
+	GEN_WRITE_(NAME##_unboxed, JNAME, UTYPE, (TYPE)) \
+	GEN_PUSH_UNBOXED(NAME, UTYPE, DST)
+
 GEN(GEN_CALL_READ_PUSH_WRITE)
-GEN_CALL_(void, Void, (void), Val_unit)
-GEN_PUSH_UNBOXED(float, double, f)
-GEN_PUSH_UNBOXED(double, double, d)
+GEN(GEN_CALL_BLOCKING)
+GEN_INTERNED(GEN_CALL_READ_PUSH_WRITE)
+GEN_INTERNED(GEN_CALL_BLOCKING)
+GEN_CALL_(void, Void, value, (void), Val_unit)
+GEN_CALL_BLOCKING_(void, Void, value, (void), Val_unit)
+GEN_FUSED_RET(GEN_CALL_FUSED_1, i)
+GEN_FUSED_RET(GEN_CALL_FUSED_1, o)
+GEN_FUSED_RET(GEN_CALL_FUSED_2, i, i)
+GEN_FUSED_RET(GEN_CALL_FUSED_2, i, o)
+GEN_FUSED_RET(GEN_CALL_FUSED_2, o, i)
+GEN_FUSED_RET(GEN_CALL_FUSED_2, o, o)
+GEN_PRIM_UNBOXED(GEN_UNBOXED)
+GEN_CALL_(object_local, Object, value, jobject res =, alloc_local_obj(res))
+GEN_READ_(object_local, Object, jobject, value, alloc_local_obj)
 
 
 #undef GEN_CALL_
 #undef GEN_CALL
+#undef GEN_CALL_BLOCKING_
+#undef GEN_CALL_BLOCKING
+#undef FUSED_ARG_i
+#undef FUSED_ARG_o
+#undef GEN_CALL_FUSED_
+#undef GEN_CALL_FUSED_1
+#undef GEN_CALL_FUSED_2
+#undef GEN_FUSED_RET
+#undef GEN_READ_
 #undef GEN_READ
 #undef GEN_PUSH
+#undef GEN_PUSH_UNBOXED
+#undef GEN_WRITE_
 #undef GEN_WRITE
+#undef GEN_UNBOXED
 
 /*
 ** ========================================================================== **
@@ -629,6 +1895,7 @@ GEN_PUSH_UNBOXED(double, double, d)
 
 static value new_object_array(jclass cls, jobject obj, jint length)
 {
+	JNIEnv *const	env = current_env_noraise();
 	jarray const	a = (*env)->NewObjectArray(env, length, cls, obj);
 	value			v;
 
@@ -640,6 +1907,7 @@ static value new_object_array(jclass cls, jobject obj, jint length)
 #define GEN_JARRAY_CREATE_PRIM(NAME, JNAME, ...) \
 value ocaml_java__jarray_create_##NAME(value length)						\
 {																			\
+	JNIEnv *const	env = current_env();									\
 	jarray const	a = (*env)->New##JNAME##Array(env, Long_val(length));	\
 	value const		v = alloc_java_obj(env, a);								\
 																			\
@@ -651,34 +1919,58 @@ GEN_PRIM(GEN_JARRAY_CREATE_PRIM)
 
 value ocaml_java__jarray_create_object(value cls, value obj, value length)
 {
-	return new_object_array(Java_obj_val(cls),
-			Java_obj_val_opt(obj),
+	int const	local_refs = local_ref_count;
+	value		v;
+
+	v = new_object_array(Java_obj_val_at(cls, local_refs),
+			Java_obj_val_opt_at(obj, local_refs),
 			Long_val(length));
+	pop_local_refs(local_refs);
+	return v;
 }
 
 value ocaml_java__jarray_create_string(value length)
 {
+	JNIEnv *const	env = current_env();
+
 	return new_object_array(CLASS(String), NULL, Long_val(length));
 }
 
 value ocaml_java__jarray_create_value(value length)
 {
+	JNIEnv *const	env = current_env();
+
 	return new_object_array(CLASS(Value), NULL, Long_val(length));
 }
 
 value ocaml_java__jarray_create_array(value cls, value obj, value length)
 {
-	jobject const obj_ = (obj == Val_none) ? NULL : Java_obj_val(Some_val(obj));
-	return new_object_array(Java_obj_val(cls), obj_, Long_val(length));
+	int const		local_refs = local_ref_count;
+	jobject const	obj_ = (obj == Val_none) ? NULL
+		: Java_obj_val_at(Some_val(obj), local_refs);
+	value			v;
+
+	v = new_object_array(Java_obj_val_at(cls, local_refs), obj_,
+			Long_val(length));
+	pop_local_refs(local_refs);
+	return v;
 }
 
 value ocaml_java__jarray_length(value array)
 {
-	return Val_long((*env)->GetArrayLength(env, Java_obj_val(array)));
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jsize const		length = (*env)->GetArrayLength(env,
+			Java_obj_val_at(array, local_refs));
+
+	pop_local_refs(local_refs);
+	return Val_long(length);
 }
 
 static void	check_out_of_bound_exception(void)
 {
+	JNIEnv *const	env = current_env_noraise();
+
 	if ((*env)->ExceptionCheck(env))
 	{
 		(*env)->ExceptionClear(env);
@@ -689,10 +1981,14 @@ static void	check_out_of_bound_exception(void)
 #define GEN_JARRAY_SET_PRIM(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
 value ocaml_java__jarray_set_##NAME(value array, value index, value v)		\
 {																			\
-	TYPE const buf = CONV_TO(v);											\
-	(*env)->Set##JNAME##ArrayRegion(env, Java_obj_val(array),				\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	TYPE const		buf = CONV_TO(v);										\
+																			\
+	(*env)->Set##JNAME##ArrayRegion(env,									\
+			Java_obj_val_at(array, local_refs),								\
 			Long_val(index), 1, &buf);										\
-	clear_local_refs();														\
+	pop_local_refs(local_refs);												\
 	check_out_of_bound_exception();											\
 	return Val_unit;														\
 }
@@ -700,9 +1996,13 @@ value ocaml_java__jarray_set_##NAME(value array, value index, value v)		\
 #define GEN_JARRAY_SET_OBJ(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
 value ocaml_java__jarray_set_##NAME(value array, value index, value v)		\
 {																			\
-	(*env)->SetObjectArrayElement(env, Java_obj_val(array),					\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+																			\
+	(*env)->SetObjectArrayElement(env,										\
+			Java_obj_val_at(array, local_refs),								\
 			Long_val(index), CONV_TO(v));									\
-	clear_local_refs();														\
+	pop_local_refs(local_refs);												\
 	check_out_of_bound_exception();											\
 	return Val_unit;														\
 }
@@ -710,9 +2010,14 @@ value ocaml_java__jarray_set_##NAME(value array, value index, value v)		\
 #define GEN_JARRAY_GET_PRIM(NAME, JNAME, TYPE, CONV_OF, ...) \
 value ocaml_java__jarray_get_##NAME(value array, value index)				\
 {																			\
-	TYPE buf;																\
-	(*env)->Get##JNAME##ArrayRegion(env, Java_obj_val(array),				\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	TYPE			buf;													\
+																			\
+	(*env)->Get##JNAME##ArrayRegion(env,									\
+			Java_obj_val_at(array, local_refs),								\
 			Long_val(index), 1, &buf);										\
+	pop_local_refs(local_refs);												\
 	check_out_of_bound_exception();											\
 	return CONV_OF(buf);													\
 }
@@ -720,55 +2025,454 @@ value ocaml_java__jarray_get_##NAME(value array, value index)				\
 #define GEN_JARRAY_GET_OBJ(NAME, JNAME, TYPE, CONV_OF, ...) \
 value ocaml_java__jarray_get_##NAME(value array, value index)				\
 {																			\
-	jobject	obj;															\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jobject			obj;													\
 																			\
 	obj = (*env)->GetObjectArrayElement(env,								\
-			Java_obj_val(array), Long_val(index));							\
+			Java_obj_val_at(array, local_refs),								\
+			Long_val(index));												\
+	pop_local_refs(local_refs);												\
 	check_out_of_bound_exception();											\
 	return CONV_OF(obj);													\
 }
 
-#define GEN_ARRAY_CONV_INT(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
-static void array_conv_##NAME(value src, mlsize_t length, TYPE *dst)		\
+// `array_conv_*` converts `length` elements of an OCaml array,
+//  starting at `pos`, does not allocate
+// `array_unconv_*` converts to an OCaml array, starting at `pos`,
+//  only the boxed versions allocate
+// The tagged and float versions use the kernels in `array_convertions.c`
+#define GEN_ARRAY_CONV_TAGGED(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
+static void array_conv_##NAME(value src, mlsize_t pos, mlsize_t length,		\
+		TYPE *dst)															\
+{																			\
+	ocaml_java__untag_##TYPE(&Field(src, pos), dst, length);				\
+}																			\
+																			\
+static void array_unconv_##NAME(TYPE const *src, mlsize_t length,			\
+		value dst, mlsize_t pos)											\
+{																			\
+	ocaml_java__tag_##TYPE(src, &Field(dst, pos), length);					\
+}
+
+#define GEN_ARRAY_CONV_BOXED(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
+static void array_conv_##NAME(value src, mlsize_t pos, mlsize_t length,		\
+		TYPE *dst)															\
+{																			\
+	mlsize_t i;																\
+	for (i = 0; i < length; i++)											\
+		dst[i] = CONV_TO(Field(src, pos + i));								\
+}																			\
+																			\
+static void array_unconv_##NAME(TYPE const *src, mlsize_t length,			\
+		value dst, mlsize_t pos)											\
 {																			\
+	CAMLparam1(dst);														\
+	CAMLlocal1(v);															\
 	mlsize_t i;																\
 	for (i = 0; i < length; i++)											\
-		dst[i] = CONV_TO(Field(src, i));									\
+	{																		\
+		v = CONV_OF(src[i]);												\
+		caml_modify(&Field(dst, pos + i), v);								\
+	}																		\
+	CAMLreturn0;															\
 }
 
 #define GEN_ARRAY_CONV_FLOAT(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
-static void array_conv_##NAME(value src, mlsize_t length, TYPE *dst)		\
+static void array_conv_##NAME(value src, mlsize_t pos, mlsize_t length,		\
+		TYPE *dst)															\
 {																			\
-	mlsize_t i;																\
-	for (i = 0; i < length; i++)											\
-		dst[i] = Double_field(src, i);										\
+	ocaml_java__from_double_##TYPE((double const*)src + pos, dst, length);	\
+}																			\
+																			\
+static void array_unconv_##NAME(TYPE const *src, mlsize_t length,			\
+		value dst, mlsize_t pos)											\
+{																			\
+	ocaml_java__to_double_##TYPE(src, (double*)dst + pos, length);			\
 }
 
-GEN_PRIM_INT(GEN_ARRAY_CONV_INT)
+GEN_PRIM_TAGGED(GEN_ARRAY_CONV_TAGGED)
+GEN_PRIM_BOXED(GEN_ARRAY_CONV_BOXED)
 GEN_PRIM_FLOAT(GEN_ARRAY_CONV_FLOAT)
 
 #define GEN_JARRAY_OF(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
 value ocaml_java__jarray_of_##NAME(value src)								\
 {																			\
+	JNIEnv *const	env = current_env();									\
+	mlsize_t const	len = caml_array_length(src);							\
+	jarray			dst;													\
+	TYPE			*buff;													\
+	value			res;													\
+																			\
+	dst = (*env)->New##JNAME##Array(env, len);								\
+	buff = (*env)->Get##JNAME##ArrayElements(env, dst, NULL);				\
+	array_conv_##NAME(src, 0, len, buff);									\
+	(*env)->Release##JNAME##ArrayElements(env, dst, buff, 0);				\
+	res = alloc_java_obj(env, dst);											\
+	(*env)->DeleteLocalRef(env, dst);										\
+	return res;																\
+}
+
+// Same as `GEN_JARRAY_OF` but raises `Invalid_argument`
+//  if a value does not fit in the Java type
+#define GEN_JARRAY_OF_CHECKED(NAME, JNAME, TYPE) \
+value ocaml_java__jarray_of_checked_##NAME(value src)						\
+{																			\
+	JNIEnv *const	env = current_env();									\
 	mlsize_t const	len = caml_array_length(src);							\
 	jarray			dst;													\
 	TYPE			*buff;													\
+	size_t			valid;													\
 	value			res;													\
+	char			msg[64];												\
 																			\
 	dst = (*env)->New##JNAME##Array(env, len);								\
 	buff = (*env)->Get##JNAME##ArrayElements(env, dst, NULL);				\
-	array_conv_##NAME(src, len, buff);										\
+	valid = ocaml_java__untag_##TYPE##_checked(&Field(src, 0), buff, len);	\
 	(*env)->Release##JNAME##ArrayElements(env, dst, buff, 0);				\
+	if (valid < len)														\
+	{																		\
+		(*env)->DeleteLocalRef(env, dst);									\
+		snprintf(msg, sizeof(msg), "Jarray.of_" #NAME						\
+			"s_checked: overflow at index %zu", valid);						\
+		caml_invalid_argument(msg);											\
+	}																		\
 	res = alloc_java_obj(env, dst);											\
 	(*env)->DeleteLocalRef(env, dst);										\
 	return res;																\
 }
 
+value ocaml_java__jarray_of_strings(value src)
+{
+	JNIEnv *const		env = current_env();
+	jobjectArray const	a = ocaml_java__to_jstring_array(env, src);
+	value				v;
+
+	v = alloc_java_obj(env, a);
+	(*env)->DeleteLocalRef(env, a);
+	return v;
+}
+
+value ocaml_java__jarray_to_strings(value array)
+{
+	JNIEnv *const		env = current_env();
+	int const			local_refs = local_ref_count;
+	jobjectArray const	a = (*env)->NewLocalRef(env,
+			Java_obj_val_at(array, local_refs));
+
+	pop_local_refs(local_refs);
+	return ocaml_java__of_jstring_array(env, a);
+}
+
+value ocaml_java__jarray_of_objects(value cls, value src)
+{
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	mlsize_t const	n = caml_array_length(src);
+	jobjectArray	a;
+	int				elem_refs;
+	mlsize_t		i;
+	value			v;
+
+	a = (*env)->NewObjectArray(env, n, Java_obj_val_at(cls, local_refs), NULL);
+	if (a == NULL)
+	{
+		(*env)->ExceptionClear(env);
+		pop_local_refs(local_refs);
+		caml_failwith("Jarray.of_objects: Allocation failed");
+	}
+	push_local_ref(a);
+	elem_refs = local_ref_count;
+	for (i = 0; i < n && !(*env)->ExceptionCheck(env); i++)
+	{
+		(*env)->SetObjectArrayElement(env, a, i,
+				Java_obj_val_opt_at(Field(src, i), local_refs));
+		pop_local_refs(elem_refs);
+	}
+	if ((*env)->ExceptionCheck(env))
+	{
+		(*env)->ExceptionClear(env);
+		pop_local_refs(local_refs);
+		caml_invalid_argument("Jarray.of_objects: Wrong class");
+	}
+	v = alloc_java_obj(env, a);
+	pop_local_refs(local_refs);
+	return v;
+}
+
+// The elements are read in local frames of `TO_OBJECTS_FRAME` refs,
+//  released all at once
+// The handles for the whole array are reserved first
+#define TO_OBJECTS_FRAME	256
+
+// Does not delete `a`
+// Raises `Failure` if a local frame cannot be allocated,
+//  the local refs above `local_refs` are popped before
+static value objects_of_jarray(jobjectArray a, int local_refs)
+{
+	CAMLparam0();
+	CAMLlocal2(result, obj);
+	JNIEnv *const	env = current_env_noraise();
+	jsize const		n = (*env)->GetArrayLength(env, a);
+	jsize			i;
+	jsize			end;
+
+	result = caml_alloc(n, 0);
+	handle_reserve(env, n);
+	for (i = 0; i < n; i = end)
+	{
+		end = (n - i < TO_OBJECTS_FRAME) ? n : i + TO_OBJECTS_FRAME;
+		if ((*env)->PushLocalFrame(env, end - i) != 0)
+		{
+			(*env)->ExceptionClear(env);
+			pop_local_refs(local_refs);
+			caml_failwith("Jarray.to_objects: Cannot allocate local frame");
+		}
+		for (; i < end; i++)
+		{
+			obj = alloc_java_obj(env, (*env)->GetObjectArrayElement(env, a, i));
+			Store_field(result, i, obj);
+		}
+		(*env)->PopLocalFrame(env, NULL);
+	}
+	CAMLreturn(result);
+}
+
+value ocaml_java__jarray_to_objects(value array)
+{
+	int const	local_refs = local_ref_count;
+	value		result;
+
+	result = objects_of_jarray(Java_obj_val_at(array, local_refs), local_refs);
+	pop_local_refs(local_refs);
+	return result;
+}
+
+// Returns true if [pos, pos + len) is in [0, length)
+static int	range_valid(intnat pos, intnat len, intnat length)
+{
+	return (pos >= 0 && len >= 0 && pos <= length - len);
+}
+
+// Raises `Invalid_argument` if the ranges are invalid
+// `array` is popped from the local refs before raising
+static void	check_ranges(jarray array, value pos, value len,
+				mlsize_t other_length, value other_pos, int local_refs,
+				char const *name)
+{
+	JNIEnv *const	env = current_env_noraise();
+
+	if (!range_valid(Long_val(pos), Long_val(len),
+				(*env)->GetArrayLength(env, array))
+		|| !range_valid(Long_val(other_pos), Long_val(len), other_length))
+	{
+		pop_local_refs(local_refs);
+		caml_invalid_argument(name);
+	}
+}
+
+// `GetPrimitiveArrayCritical` that raises on failure
+// No JNI function can be called and nothing can be allocated
+//  until `ReleasePrimitiveArrayCritical`
+static void	*get_critical(jarray array, int local_refs)
+{
+	JNIEnv *const	env = current_env_noraise();
+	void *const		p = (*env)->GetPrimitiveArrayCritical(env, array, NULL);
+
+	if (p == NULL)
+	{
+		(*env)->ExceptionClear(env);
+		pop_local_refs(local_refs);
+		caml_raise_out_of_memory();
+	}
+	return p;
+}
+
+// The whole range is converted in a critical section
+#define GEN_JARRAY_BLIT_OF_ARRAY(NAME, JNAME, TYPE, ...) \
+value ocaml_java__jarray_blit_of_array_##NAME(value src, value src_pos,		\
+		value dst, value dst_pos, value len)								\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jarray const	a = Java_obj_val_at(dst, local_refs);					\
+	TYPE			*buff;													\
+																			\
+	check_ranges(a, dst_pos, len, caml_array_length(src), src_pos,			\
+		local_refs, "Jarray.blit_of_array");								\
+	buff = get_critical(a, local_refs);										\
+	array_conv_##NAME(src, Long_val(src_pos), Long_val(len),				\
+		buff + Long_val(dst_pos));											\
+	(*env)->ReleasePrimitiveArrayCritical(env, a, buff, 0);					\
+	pop_local_refs(local_refs);												\
+	return Val_unit;														\
+}
+
+// Same as `GEN_JARRAY_BLIT_OF_ARRAY`, in the other direction
+#define GEN_JARRAY_BLIT_TO_ARRAY(NAME, JNAME, TYPE, ...) \
+value ocaml_java__jarray_blit_to_array_##NAME(value src, value src_pos,		\
+		value dst, value dst_pos, value len)								\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jarray const	a = Java_obj_val_at(src, local_refs);					\
+	TYPE			*buff;													\
+																			\
+	check_ranges(a, src_pos, len, caml_array_length(dst), dst_pos,			\
+		local_refs, "Jarray.blit_to_array");								\
+	buff = get_critical(a, local_refs);										\
+	array_unconv_##NAME(buff + Long_val(src_pos), Long_val(len),			\
+		dst, Long_val(dst_pos));											\
+	(*env)->ReleasePrimitiveArrayCritical(env, a, buff, JNI_ABORT);			\
+	pop_local_refs(local_refs);												\
+	return Val_unit;														\
+}
+
+// The boxed versions allocate, the range is copied with a single
+//  region call first
+#define GEN_JARRAY_BLIT_TO_ARRAY_BOXED(NAME, JNAME, TYPE, ...) \
+value ocaml_java__jarray_blit_to_array_##NAME(value src, value src_pos,		\
+		value dst, value dst_pos, value len)								\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jarray const	a = Java_obj_val_at(src, local_refs);					\
+	TYPE			*buff;													\
+																			\
+	check_ranges(a, src_pos, len, caml_array_length(dst), dst_pos,			\
+		local_refs, "Jarray.blit_to_array");								\
+	buff = malloc(Long_val(len) * sizeof(TYPE) + 1);						\
+	if (buff == NULL)														\
+	{																		\
+		pop_local_refs(local_refs);											\
+		caml_raise_out_of_memory();											\
+	}																		\
+	(*env)->Get##JNAME##ArrayRegion(env, a, Long_val(src_pos),				\
+		Long_val(len), buff);												\
+	pop_local_refs(local_refs);												\
+	array_unconv_##NAME(buff, Long_val(len), dst, Long_val(dst_pos));		\
+	free(buff);																\
+	return Val_unit;														\
+}
+
+#define GEN_JARRAY_FILL(NAME, JNAME, TYPE, CONV_OF, DST, CONV_TO) \
+value ocaml_java__jarray_fill_##NAME(value array, value pos, value len,		\
+		value v)															\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jarray const	a = Java_obj_val_at(array, local_refs);					\
+	TYPE const		x = CONV_TO(v);											\
+	TYPE			*buff;													\
+	intnat			i;														\
+																			\
+	check_ranges(a, pos, len, Long_val(len), Val_long(0), local_refs,		\
+		"Jarray.fill");														\
+	buff = get_critical(a, local_refs);										\
+	for (i = Long_val(pos); i < Long_val(pos) + Long_val(len); i++)			\
+		buff[i] = x;														\
+	(*env)->ReleasePrimitiveArrayCritical(env, a, buff, 0);					\
+	pop_local_refs(local_refs);												\
+	return Val_unit;														\
+}
+
+// Both arrays are accessed in critical sections
+#define GEN_JARRAY_SUB(NAME, JNAME, TYPE, ...) \
+value ocaml_java__jarray_sub_##NAME(value array, value pos, value len)		\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jarray const	a = Java_obj_val_at(array, local_refs);					\
+	jarray			dst;													\
+	TYPE			*src_buff;												\
+	TYPE			*dst_buff;												\
+	value			v;														\
+																			\
+	check_ranges(a, pos, len, Long_val(len), Val_long(0), local_refs,		\
+		"Jarray.sub");														\
+	dst = (*env)->New##JNAME##Array(env, Long_val(len));					\
+	if (dst == NULL)														\
+	{																		\
+		(*env)->ExceptionClear(env);										\
+		pop_local_refs(local_refs);											\
+		caml_raise_out_of_memory();											\
+	}																		\
+	src_buff = get_critical(a, local_refs);									\
+	dst_buff = (*env)->GetPrimitiveArrayCritical(env, dst, NULL);			\
+	if (dst_buff != NULL)													\
+	{																		\
+		memcpy(dst_buff, src_buff + Long_val(pos),							\
+			Long_val(len) * sizeof(TYPE));									\
+		(*env)->ReleasePrimitiveArrayCritical(env, dst, dst_buff, 0);		\
+	}																		\
+	(*env)->ReleasePrimitiveArrayCritical(env, a, src_buff, JNI_ABORT);		\
+	pop_local_refs(local_refs);												\
+	if (dst_buff == NULL)													\
+	{																		\
+		(*env)->ExceptionClear(env);										\
+		(*env)->DeleteLocalRef(env, dst);									\
+		caml_raise_out_of_memory();											\
+	}																		\
+	v = alloc_java_obj(env, dst);											\
+	(*env)->DeleteLocalRef(env, dst);										\
+	return v;																\
+}
+
+// Copies the whole array with a single region call
+#define GEN_JARRAY_TO_BIGARRAY(NAME, JNAME, TYPE, KIND) \
+value ocaml_java__jarray_to_bigarray_##NAME(value array)					\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	int const		local_refs = local_ref_count;							\
+	jarray const	a = Java_obj_val_at(array, local_refs);					\
+	jsize const		length = (*env)->GetArrayLength(env, a);				\
+	value			ba;														\
+																			\
+	ba = caml_ba_alloc_dims(KIND | CAML_BA_C_LAYOUT, 1, NULL,				\
+			(intnat)length);												\
+	(*env)->Get##JNAME##ArrayRegion(env, a, 0, length,						\
+		(TYPE*)Caml_ba_data_val(ba));										\
+	pop_local_refs(local_refs);												\
+	return ba;																\
+}
+
+#define GEN_JARRAY_OF_BIGARRAY(NAME, JNAME, TYPE, KIND) \
+value ocaml_java__jarray_of_bigarray_##NAME(value ba)						\
+{																			\
+	JNIEnv *const	env = current_env();									\
+	jsize const		length = Caml_ba_array_val(ba)->dim[0];					\
+	jarray			a;														\
+	value			v;														\
+																			\
+	a = (*env)->New##JNAME##Array(env, length);								\
+	if (a == NULL)															\
+	{																		\
+		(*env)->ExceptionClear(env);										\
+		caml_failwith("Jarray.of_bigarray: Allocation failed");				\
+	}																		\
+	(*env)->Set##JNAME##ArrayRegion(env, a, 0, length,						\
+		(TYPE const*)Caml_ba_data_val(ba));									\
+	v = alloc_java_obj(env, a);												\
+	(*env)->DeleteLocalRef(env, a);											\
+	return v;																\
+}
+
 GEN_PRIM(GEN_JARRAY_SET_PRIM)
 GEN_OBJ(GEN_JARRAY_SET_OBJ)
 GEN_PRIM(GEN_JARRAY_GET_PRIM)
 GEN_OBJ(GEN_JARRAY_GET_OBJ)
 GEN_PRIM(GEN_JARRAY_OF)
+GEN_JARRAY_OF_CHECKED(int, Int, jint)
+GEN_JARRAY_OF_CHECKED(byte, Byte, jbyte)
+GEN_JARRAY_OF_CHECKED(short, Short, jshort)
+GEN_PRIM(GEN_JARRAY_BLIT_OF_ARRAY)
+GEN_PRIM_TAGGED(GEN_JARRAY_BLIT_TO_ARRAY)
+GEN_PRIM_BOXED(GEN_JARRAY_BLIT_TO_ARRAY_BOXED)
+GEN_PRIM_FLOAT(GEN_JARRAY_BLIT_TO_ARRAY)
+GEN_PRIM(GEN_JARRAY_FILL)
+GEN_PRIM(GEN_JARRAY_SUB)
+GEN_PRIM_BIGARRAY(GEN_JARRAY_TO_BIGARRAY)
+GEN_PRIM_BIGARRAY(GEN_JARRAY_OF_BIGARRAY)
 
 /*
 ** ========================================================================== **
@@ -777,13 +2481,21 @@ GEN_PRIM(GEN_JARRAY_OF)
 
 value ocaml_java__jthrowable_throw(value thrwbl)
 {
-	(*env)->Throw(env, Java_obj_val(thrwbl));
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+
+	(*env)->Throw(env, Java_obj_val_at(thrwbl, local_refs));
+	pop_local_refs(local_refs);
 	return Val_unit;
 }
 
 value ocaml_java__jthrowable_throw_new(value cls, value msg)
 {
-	(*env)->ThrowNew(env, Java_obj_val(cls), String_val(msg));
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+
+	(*env)->ThrowNew(env, Java_obj_val_at(cls, local_refs), String_val(msg));
+	pop_local_refs(local_refs);
 	return Val_unit;
 }
 
@@ -795,29 +2507,285 @@ value ocaml_java__jthrowable_throw_new(value cls, value msg)
 // Very similar to ocaml_java__jvalue_new
 value ocaml_java__runnable_create(value run)
 {
-	value *const	global = caml_stat_alloc(sizeof(value));
+	JNIEnv *const	env = current_env();
+	value *const	global = ocaml_java__jvalue_alloc(run);
 	jobject			obj;
+	value			v;
 
-	caml_register_global_root(global);
-	*global = run;
 	obj = (*env)->NewObject(env, CLASS(RunnableValue), CONSTR(RunnableValue),
 		(jlong)global);
-	return alloc_java_obj(env, obj);
+	v = alloc_java_obj(env, obj);
+	(*env)->DeleteLocalRef(env, obj);
+	return v;
 }
 
 value ocaml_java__runnable_run(value t)
 {
-	jobject const obj = Java_obj_val(t);
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jobject const	obj = Java_obj_val_at(t, local_refs);
 
 	(*env)->CallVoidMethod(env, obj, METHOD(Runnable, run));
+	pop_local_refs(local_refs);
 	check_exceptions();
 	return Val_unit;
 }
 
 value ocaml_java__runnable_of_obj(value obj)
 {
-	if (obj == Java_null_val
-		|| !(*env)->IsInstanceOf(env, Java_obj_val(obj), CLASS(Runnable)))
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	int				r;
+
+	r = obj != Java_null_val
+		&& (*env)->IsInstanceOf(env, Java_obj_val_at(obj, local_refs),
+			CLASS(Runnable));
+	pop_local_refs(local_refs);
+	if (!r)
 		caml_failwith("Jrunnable.of_obj");
 	return obj;
 }
+
+/*
+** ========================================================================== **
+** Jbuffer API
+** -
+** The ByteBuffer created by `of_bigarray` keeps the Bigarray alive
+** 		through a juloo.javacaml.BufferValue
+** The Bigarray created by `to_bigarray` does not own its data
+** 		(CAML_BA_EXTERNAL), the buffer is kept alive by `jbuffer.ml`
+*/
+
+value ocaml_java__jbuffer_of_bigarray(value ba)
+{
+	JNIEnv *const				env = current_env();
+	struct caml_ba_array *const	b = Caml_ba_array_val(ba);
+	jobject						buffer;
+	jobject						owner;
+	value						v;
+
+	buffer = (*env)->NewDirectByteBuffer(env, b->data, caml_ba_byte_size(b));
+	if (buffer == NULL)
+	{
+		(*env)->ExceptionClear(env);
+		caml_failwith("Jbuffer.of_bigarray: Direct buffers are not supported");
+	}
+	owner = JVALUE_NEW(env, ba);
+	(*env)->CallStaticVoidMethod(env, CLASS(BufferValue),
+		STATIC_METHOD(BufferValue, wrap), buffer, owner);
+	(*env)->DeleteLocalRef(env, owner);
+	v = alloc_java_obj(env, buffer);
+	(*env)->DeleteLocalRef(env, buffer);
+	return v;
+}
+
+value ocaml_java__jbuffer_to_bigarray(value kind, value obj)
+{
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jobject			buffer;
+	void			*data;
+	jlong			capacity;
+
+	if (obj == Java_null_val)
+		caml_failwith("Jbuffer.to_bigarray: null");
+	buffer = Java_obj_val_at(obj, local_refs);
+	data = (*env)->GetDirectBufferAddress(env, buffer);
+	capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+	if (data == NULL || capacity < 0)
+	{
+		pop_local_refs(local_refs);
+		caml_failwith("Jbuffer.to_bigarray: Not a direct buffer");
+	}
+	pop_local_refs(local_refs);
+	return caml_ba_alloc_dims(Int_val(kind) | CAML_BA_C_LAYOUT
+		| CAML_BA_EXTERNAL, 1, data,
+		(intnat)(capacity / caml_ba_element_size[Int_val(kind)]));
+}
+
+/*
+** ========================================================================== **
+** Jcollection API
+** -
+** Collections are read by chunks by `juloo.javacaml.CollectionChunks`
+** 		a chunk is a Java array converted in a single call
+** The kinds are the same as in `jcollection.ml` and `CollectionChunks.java`
+*/
+
+#define CHUNK_OBJECT	0
+#define CHUNK_STRING	1
+#define CHUNK_INT		2
+#define CHUNK_FLOAT		3
+
+// Converts a chunk, deletes `chunk`
+// If the conversion raises, the local refs above `local_refs` are deleted too
+// A `null` chunk is a string chunk with a `null` element
+// The int and float chunks are copied directly into the OCaml array
+static value of_chunk(jarray chunk, int kind, int local_refs)
+{
+	JNIEnv *const	env = current_env_noraise();
+	int const		top = local_ref_count;
+	jsize			n;
+	value			v;
+	void			*buff;
+
+	if (chunk == NULL)
+	{
+		pop_local_refs(local_refs);
+		caml_failwith("Null string");
+	}
+	if (kind == CHUNK_STRING)
+		return ocaml_java__of_jstring_array(env, chunk);
+	n = (*env)->GetArrayLength(env, push_local_ref(chunk));
+	switch (kind)
+	{
+	case CHUNK_INT:
+		v = caml_alloc(n, 0);
+		buff = get_critical(chunk, local_refs);
+		ocaml_java__tag_jlong(buff, &Field(v, 0), n);
+		(*env)->ReleasePrimitiveArrayCritical(env, chunk, buff, JNI_ABORT);
+		break ;
+	case CHUNK_FLOAT:
+		v = (n == 0) ? Atom(0) : caml_alloc(n * Double_wosize, Double_array_tag);
+		(*env)->GetDoubleArrayRegion(env, chunk, 0, n, (jdouble*)v);
+		break ;
+	default:
+		v = objects_of_jarray(chunk, local_refs);
+		break ;
+	}
+	pop_local_refs(top);
+	return v;
+}
+
+value ocaml_java__jcollection_iterator(value coll)
+{
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jobject			it;
+	value			v;
+
+	it = (*env)->CallStaticObjectMethod(env, CLASS(CollectionChunks),
+			STATIC_METHOD(CollectionChunks, iterator),
+			Java_obj_val_at(coll, local_refs));
+	pop_local_refs(local_refs);
+	check_exceptions();
+	v = alloc_java_obj(env, it);
+	(*env)->DeleteLocalRef(env, it);
+	return v;
+}
+
+value ocaml_java__jcollection_next(value it, value max, value kind)
+{
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jarray			chunk;
+
+	chunk = (*env)->CallStaticObjectMethod(env, CLASS(CollectionChunks),
+			STATIC_METHOD(CollectionChunks, next),
+			Java_obj_val_at(it, local_refs),
+			(jint)Long_val(max), (jint)Long_val(kind));
+	pop_local_refs(local_refs);
+	check_exceptions();
+	return of_chunk(chunk, Long_val(kind), local_refs);
+}
+
+value ocaml_java__jcollection_next_entries(value it, value max,
+		value key_kind, value value_kind)
+{
+	CAMLparam0();
+	CAMLlocal3(keys, values, result);
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	jobjectArray	chunks;
+	jarray			values_chunk;
+
+	chunks = (*env)->CallStaticObjectMethod(env, CLASS(CollectionChunks),
+			STATIC_METHOD(CollectionChunks, nextEntries),
+			Java_obj_val_at(it, local_refs),
+			(jint)Long_val(max), (jint)Long_val(key_kind),
+			(jint)Long_val(value_kind));
+	pop_local_refs(local_refs);
+	check_exceptions();
+	push_local_ref(chunks);
+	keys = of_chunk((*env)->GetObjectArrayElement(env, chunks, 0),
+			Long_val(key_kind), local_refs);
+	values_chunk = (*env)->GetObjectArrayElement(env, chunks, 1);
+	pop_local_refs(local_refs);
+	values = of_chunk(values_chunk, Long_val(value_kind), local_refs);
+	result = caml_alloc_small(2, 0);
+	Field(result, 0) = keys;
+	Field(result, 1) = values;
+	CAMLreturn(result);
+}
+
+/*
+** ========================================================================== **
+** Jexecutor API
+** -
+** A juloo.javacaml.CamlExecutor writes a byte to the pipe `wake_fd`
+** 		when tasks are submitted (see `CamlExecutor.wake` in `caml.c`)
+** Both ends of the pipe are non-blocking
+*/
+
+value ocaml_java__jexecutor_create(value unit)
+{
+	CAMLparam0();
+	CAMLlocal2(obj, result);
+	JNIEnv *const	env = current_env();
+	int				fds[2];
+	jobject			executor;
+
+	if (pipe(fds) != 0)
+		caml_failwith("Jexecutor.create: pipe");
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+	fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+	executor = (*env)->NewObject(env, CLASS(CamlExecutor),
+			CONSTR(CamlExecutor), (jint)fds[1]);
+	if (executor == NULL)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		check_exceptions();
+	}
+	obj = alloc_java_obj(env, executor);
+	(*env)->DeleteLocalRef(env, executor);
+	result = caml_alloc_small(2, 0);
+	Field(result, 0) = obj;
+	Field(result, 1) = Val_int(fds[0]);
+	CAMLreturn(result);
+	(void)unit;
+}
+
+// Empties the pipe then runs at most `max` tasks
+value ocaml_java__jexecutor_run(value executor, value fd, value max)
+{
+	JNIEnv *const	env = current_env();
+	int const		local_refs = local_ref_count;
+	char			buff[64];
+	jint			n;
+
+	while (read(Int_val(fd), buff, sizeof(buff)) > 0)
+		;
+	n = (*env)->CallIntMethod(env, Java_obj_val_at(executor, local_refs),
+			METHOD(CamlExecutor, run), (jint)Long_val(max));
+	pop_local_refs(local_refs);
+	check_exceptions();
+	return Val_long(n);
+}
+
+// Blocks until the pipe is readable, releases the runtime lock meanwhile
+value ocaml_java__jexecutor_wait(value fd)
+{
+	struct pollfd	pfd;
+
+	pfd.fd = Int_val(fd);
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	caml_enter_blocking_section();
+	while (poll(&pfd, 1, -1) < 0 && errno == EINTR)
+		;
+	caml_leave_blocking_section();
+	return Val_unit;
+}
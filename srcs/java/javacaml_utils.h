@@ -17,6 +17,46 @@
 value ocaml_java__of_jstring(JNIEnv *env, jstring str);
 jstring ocaml_java__to_jstring(JNIEnv *env, value str);
 
+// Convertion of string arrays, in a single call to Java
+// `ocaml_java__of_jstring_array` allocs an OCaml array of strings,
+//  deletes `array`
+// `ocaml_java__to_jstring_array` returns a local ref to a String[]
+value ocaml_java__of_jstring_array(JNIEnv *env, jobjectArray array);
+jobjectArray ocaml_java__to_jstring_array(JNIEnv *env, value src);
+
+// Convertion between OCaml arrays and Java primitive arrays
+// See `array_convertions.c`
+void ocaml_java__untag_jint(value const *src, jint *dst, size_t n);
+void ocaml_java__untag_jlong(value const *src, jlong *dst, size_t n);
+void ocaml_java__untag_jshort(value const *src, jshort *dst, size_t n);
+void ocaml_java__untag_jchar(value const *src, jchar *dst, size_t n);
+void ocaml_java__untag_jbyte(value const *src, jbyte *dst, size_t n);
+void ocaml_java__untag_jboolean(value const *src, jboolean *dst, size_t n);
+void ocaml_java__tag_jint(jint const *src, value *dst, size_t n);
+void ocaml_java__tag_jlong(jlong const *src, value *dst, size_t n);
+void ocaml_java__tag_jshort(jshort const *src, value *dst, size_t n);
+void ocaml_java__tag_jchar(jchar const *src, value *dst, size_t n);
+void ocaml_java__tag_jbyte(jbyte const *src, value *dst, size_t n);
+void ocaml_java__tag_jboolean(jboolean const *src, value *dst, size_t n);
+size_t ocaml_java__untag_jint_checked(value const *src, jint *dst, size_t n);
+size_t ocaml_java__untag_jshort_checked(value const *src, jshort *dst,
+		size_t n);
+size_t ocaml_java__untag_jbyte_checked(value const *src, jbyte *dst, size_t n);
+void ocaml_java__from_double_jfloat(double const *src, jfloat *dst, size_t n);
+void ocaml_java__to_double_jfloat(jfloat const *src, double *dst, size_t n);
+void ocaml_java__from_double_jdouble(double const *src, jdouble *dst,
+		size_t n);
+void ocaml_java__to_double_jdouble(jdouble const *src, double *dst, size_t n);
+
+// Cells holding the values pointed to by juloo.javacaml.Value objects
+// Both must be called with the runtime lock
+value *ocaml_java__jvalue_alloc(value v);
+void ocaml_java__jvalue_release(value *v);
+
+// Releases the Values whose objects have been collected (see `Value.collect`)
+// Must be called with the runtime lock
+void ocaml_java__jvalue_collect(JNIEnv *env);
+
 // Returns a new juloo.javacaml.Value pointing to `v`
 jobject ocaml_java__jvalue_new(JNIEnv *env, value v);
 value ocaml_java__jvalue_get(JNIEnv *env, jobject v);
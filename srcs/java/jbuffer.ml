@@ -0,0 +1,23 @@
+external of_bigarray :
+	('a, 'b, Bigarray.c_layout) Bigarray.Array1.t -> 'c Java.obj
+	= "ocaml_java__jbuffer_of_bigarray"
+
+external to_bigarray_unsafe :
+	('a, 'b) Bigarray.kind -> 'c Java.obj ->
+	('a, 'b, Bigarray.c_layout) Bigarray.Array1.t
+	= "ocaml_java__jbuffer_to_bigarray"
+
+(* The Bigarray does not own its data, `owner` is reachable from
+	the finaliser until the Bigarray is dead *)
+let keep_alive ba owner =
+	Gc.finalise (fun _ -> ignore (Sys.opaque_identity owner)) ba
+
+let to_bigarray kind buffer =
+	let ba = to_bigarray_unsafe kind buffer in
+	keep_alive ba buffer;
+	ba
+
+let sub ba ofs len =
+	let sub = Bigarray.Array1.sub ba ofs len in
+	keep_alive sub ba;
+	sub
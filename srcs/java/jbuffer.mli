@@ -0,0 +1,30 @@
+(** Sharing memory between OCaml Bigarrays and Java direct ByteBuffers
+	The data is not copied, both sides see the changes
+	Multi-byte elements are in the native byte order,
+		Java should use `buffer.order(ByteOrder.nativeOrder())` to read them *)
+
+(** Creates a direct ByteBuffer pointing to the data of a Bigarray
+	The capacity of the buffer is the size of the Bigarray in bytes
+	The Bigarray is kept alive while the buffer (or a view of it)
+		is reachable from Java
+	Raises `Failure` if the JVM does not support direct buffers *)
+val of_bigarray :
+	('a, 'b, Bigarray.c_layout) Bigarray.Array1.t -> 'c Java.obj
+
+(** `to_bigarray kind buffer`
+	Creates a Bigarray pointing to the data of a direct Buffer
+	The length is the capacity of the buffer divided by the size of `kind`
+	The buffer is kept alive while the returned Bigarray is reachable,
+		but not by the views of the Bigarray (`Array1.sub`, `reshape`, etc.),
+		use `sub` instead
+	Raises `Failure` if the buffer is `null` or is not a direct buffer *)
+val to_bigarray :
+	('a, 'b) Bigarray.kind -> 'c Java.obj ->
+	('a, 'b, Bigarray.c_layout) Bigarray.Array1.t
+
+(** Same as `Bigarray.Array1.sub`
+	The sub-array keeps the Bigarray alive, and so its buffer
+		if it was created by `to_bigarray` *)
+val sub :
+	('a, 'b, Bigarray.c_layout) Bigarray.Array1.t -> int -> int ->
+	('a, 'b, Bigarray.c_layout) Bigarray.Array1.t
@@ -3,39 +3,51 @@ open Jclass
 
 external new_ : jclass -> meth_constructor -> _ obj = "ocaml_java__new"
 
-external push_int : int -> unit = "ocaml_java__push_int" [@@noalloc]
+external push_int : (int [@untagged]) -> unit
+	= "ocaml_java__push_int" "ocaml_java__push_int_unboxed" [@@noalloc]
 external push_bool : bool -> unit = "ocaml_java__push_bool" [@@noalloc]
-external push_byte : int -> unit = "ocaml_java__push_byte" [@@noalloc]
-external push_short : int -> unit = "ocaml_java__push_short" [@@noalloc]
-external push_int32 : int32 -> unit = "ocaml_java__push_int32" [@@noalloc]
-external push_long : int64 -> unit = "ocaml_java__push_long" [@@noalloc]
+external push_byte : (int [@untagged]) -> unit
+	= "ocaml_java__push_byte" "ocaml_java__push_byte_unboxed" [@@noalloc]
+external push_short : (int [@untagged]) -> unit
+	= "ocaml_java__push_short" "ocaml_java__push_short_unboxed" [@@noalloc]
+external push_int32 : (int32 [@unboxed]) -> unit
+	= "ocaml_java__push_int32" "ocaml_java__push_int32_unboxed" [@@noalloc]
+external push_long : (int64 [@unboxed]) -> unit
+	= "ocaml_java__push_long" "ocaml_java__push_long_unboxed" [@@noalloc]
 external push_char : char -> unit = "ocaml_java__push_char" [@@noalloc]
 external push_float : (float [@unboxed]) -> unit
 	= "ocaml_java__push_float" "ocaml_java__push_float_unboxed" [@@noalloc]
 external push_double : (float [@unboxed]) -> unit
 	= "ocaml_java__push_double" "ocaml_java__push_double_unboxed" [@@noalloc]
-external push_string : string -> unit = "ocaml_java__push_string" [@@noalloc]
+external push_string : string -> unit = "ocaml_java__push_string"
 external push_string_opt : string option -> unit
-	= "ocaml_java__push_string_opt" [@@noalloc]
-external push_object : _ obj -> unit = "ocaml_java__push_object" [@@noalloc]
+	= "ocaml_java__push_string_opt"
+external push_object : _ obj -> unit = "ocaml_java__push_object"
 external push_value : 'a -> unit = "ocaml_java__push_value" [@@noalloc]
 external push_value_opt : 'a option -> unit
 	= "ocaml_java__push_value_opt" [@@noalloc]
 external push_array : 'a jarray -> unit
-	= "ocaml_java__push_array" [@@noalloc]
+	= "ocaml_java__push_array"
 external push_array_opt : 'a jarray option -> unit
-	= "ocaml_java__push_array_opt" [@@noalloc]
+	= "ocaml_java__push_array_opt"
 
 external call_void : _ obj -> meth -> unit = "ocaml_java__call_void"
-external call_int : _ obj -> meth -> int = "ocaml_java__call_int"
+external call_int : _ obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_int" "ocaml_java__call_int_unboxed"
 external call_bool : _ obj -> meth -> bool = "ocaml_java__call_bool"
-external call_byte : _ obj -> meth -> int = "ocaml_java__call_byte"
-external call_short : _ obj -> meth -> int = "ocaml_java__call_short"
-external call_int32 : _ obj -> meth -> int32 = "ocaml_java__call_int32"
-external call_long : _ obj -> meth -> int64 = "ocaml_java__call_long"
+external call_byte : _ obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_byte" "ocaml_java__call_byte_unboxed"
+external call_short : _ obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_short" "ocaml_java__call_short_unboxed"
+external call_int32 : _ obj -> meth -> (int32 [@unboxed])
+	= "ocaml_java__call_int32" "ocaml_java__call_int32_unboxed"
+external call_long : _ obj -> meth -> (int64 [@unboxed])
+	= "ocaml_java__call_long" "ocaml_java__call_long_unboxed"
 external call_char : _ obj -> meth -> char = "ocaml_java__call_char"
-external call_float : _ obj -> meth -> float = "ocaml_java__call_float"
-external call_double : _ obj -> meth -> float = "ocaml_java__call_double"
+external call_float : _ obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_float" "ocaml_java__call_float_unboxed"
+external call_double : _ obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_double" "ocaml_java__call_double_unboxed"
 external call_string : _ obj -> meth -> string = "ocaml_java__call_string"
 external call_string_opt : _ obj -> meth -> string option
 	= "ocaml_java__call_string_opt"
@@ -50,24 +62,24 @@ external call_array_opt : _ obj -> meth -> 'a jarray option
 
 external call_static_void : jclass -> meth_static -> unit
 	= "ocaml_java__call_static_void"
-external call_static_int : jclass -> meth_static -> int
-	= "ocaml_java__call_static_int"
+external call_static_int : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_int" "ocaml_java__call_static_int_unboxed"
 external call_static_bool : jclass -> meth_static -> bool
 	= "ocaml_java__call_static_bool"
-external call_static_byte : jclass -> meth_static -> int
-	= "ocaml_java__call_static_byte"
-external call_static_short : jclass -> meth_static -> int
-	= "ocaml_java__call_static_short"
-external call_static_int32 : jclass -> meth_static -> int32
-	= "ocaml_java__call_static_int32"
-external call_static_long : jclass -> meth_static -> int64
-	= "ocaml_java__call_static_long"
+external call_static_byte : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_byte" "ocaml_java__call_static_byte_unboxed"
+external call_static_short : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_short" "ocaml_java__call_static_short_unboxed"
+external call_static_int32 : jclass -> meth_static -> (int32 [@unboxed])
+	= "ocaml_java__call_static_int32" "ocaml_java__call_static_int32_unboxed"
+external call_static_long : jclass -> meth_static -> (int64 [@unboxed])
+	= "ocaml_java__call_static_long" "ocaml_java__call_static_long_unboxed"
 external call_static_char : jclass -> meth_static -> char
 	= "ocaml_java__call_static_char"
-external call_static_float : jclass -> meth_static -> float
-	= "ocaml_java__call_static_float"
-external call_static_double : jclass -> meth_static -> float
-	= "ocaml_java__call_static_double"
+external call_static_float : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_float" "ocaml_java__call_static_float_unboxed"
+external call_static_double : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_double" "ocaml_java__call_static_double_unboxed"
 external call_static_string : jclass -> meth_static -> string
 	= "ocaml_java__call_static_string"
 external call_static_string_opt : jclass -> meth_static -> string option
@@ -85,24 +97,24 @@ external call_static_array_opt : jclass -> meth_static -> 'a jarray option
 
 external call_nonvirtual_void : _ obj -> jclass -> meth -> unit
 	= "ocaml_java__call_nonvirtual_void"
-external call_nonvirtual_int : _ obj -> jclass -> meth -> int
-	= "ocaml_java__call_nonvirtual_int"
+external call_nonvirtual_int : _ obj -> jclass -> meth -> (int [@untagged])
+	= "ocaml_java__call_nonvirtual_int" "ocaml_java__call_nonvirtual_int_unboxed"
 external call_nonvirtual_bool : _ obj -> jclass -> meth -> bool
 	= "ocaml_java__call_nonvirtual_bool"
-external call_nonvirtual_byte : _ obj -> jclass -> meth -> int
-	= "ocaml_java__call_nonvirtual_byte"
-external call_nonvirtual_short : _ obj -> jclass -> meth -> int
-	= "ocaml_java__call_nonvirtual_short"
-external call_nonvirtual_int32 : _ obj -> jclass -> meth -> int32
-	= "ocaml_java__call_nonvirtual_int32"
-external call_nonvirtual_long : _ obj -> jclass -> meth -> int64
-	= "ocaml_java__call_nonvirtual_long"
+external call_nonvirtual_byte : _ obj -> jclass -> meth -> (int [@untagged])
+	= "ocaml_java__call_nonvirtual_byte" "ocaml_java__call_nonvirtual_byte_unboxed"
+external call_nonvirtual_short : _ obj -> jclass -> meth -> (int [@untagged])
+	= "ocaml_java__call_nonvirtual_short" "ocaml_java__call_nonvirtual_short_unboxed"
+external call_nonvirtual_int32 : _ obj -> jclass -> meth -> (int32 [@unboxed])
+	= "ocaml_java__call_nonvirtual_int32" "ocaml_java__call_nonvirtual_int32_unboxed"
+external call_nonvirtual_long : _ obj -> jclass -> meth -> (int64 [@unboxed])
+	= "ocaml_java__call_nonvirtual_long" "ocaml_java__call_nonvirtual_long_unboxed"
 external call_nonvirtual_char : _ obj -> jclass -> meth -> char
 	= "ocaml_java__call_nonvirtual_char"
-external call_nonvirtual_float : _ obj -> jclass -> meth -> float
-	= "ocaml_java__call_nonvirtual_float"
-external call_nonvirtual_double : _ obj -> jclass -> meth -> float
-	= "ocaml_java__call_nonvirtual_double"
+external call_nonvirtual_float : _ obj -> jclass -> meth -> (float [@unboxed])
+	= "ocaml_java__call_nonvirtual_float" "ocaml_java__call_nonvirtual_float_unboxed"
+external call_nonvirtual_double : _ obj -> jclass -> meth -> (float [@unboxed])
+	= "ocaml_java__call_nonvirtual_double" "ocaml_java__call_nonvirtual_double_unboxed"
 external call_nonvirtual_string : _ obj -> jclass -> meth -> string
 	= "ocaml_java__call_nonvirtual_string"
 external call_nonvirtual_string_opt : _ obj -> jclass -> meth -> string option
@@ -118,24 +130,227 @@ external call_nonvirtual_array : _ obj -> jclass -> meth -> 'a jarray
 external call_nonvirtual_array_opt : _ obj -> jclass -> meth -> 'a jarray option
 	= "ocaml_java__call_nonvirtual_array_opt"
 
-external read_field_int : _ obj -> field -> int
-	= "ocaml_java__read_field_int"
+external call_blocking_void : _ obj -> meth -> unit
+	= "ocaml_java__call_blocking_void"
+external call_blocking_int : _ obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_blocking_int" "ocaml_java__call_blocking_int_unboxed"
+external call_blocking_bool : _ obj -> meth -> bool
+	= "ocaml_java__call_blocking_bool"
+external call_blocking_byte : _ obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_blocking_byte" "ocaml_java__call_blocking_byte_unboxed"
+external call_blocking_short : _ obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_blocking_short" "ocaml_java__call_blocking_short_unboxed"
+external call_blocking_int32 : _ obj -> meth -> (int32 [@unboxed])
+	= "ocaml_java__call_blocking_int32" "ocaml_java__call_blocking_int32_unboxed"
+external call_blocking_long : _ obj -> meth -> (int64 [@unboxed])
+	= "ocaml_java__call_blocking_long" "ocaml_java__call_blocking_long_unboxed"
+external call_blocking_char : _ obj -> meth -> char
+	= "ocaml_java__call_blocking_char"
+external call_blocking_float : _ obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_blocking_float" "ocaml_java__call_blocking_float_unboxed"
+external call_blocking_double : _ obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_blocking_double" "ocaml_java__call_blocking_double_unboxed"
+external call_blocking_string : _ obj -> meth -> string
+	= "ocaml_java__call_blocking_string"
+external call_blocking_string_opt : _ obj -> meth -> string option
+	= "ocaml_java__call_blocking_string_opt"
+external call_blocking_object : _ obj -> meth -> _ obj
+	= "ocaml_java__call_blocking_object"
+external call_blocking_value : _ obj -> meth -> 'a
+	= "ocaml_java__call_blocking_value"
+external call_blocking_value_opt : _ obj -> meth -> 'a option
+	= "ocaml_java__call_blocking_value_opt"
+external call_blocking_array : _ obj -> meth -> 'a jarray
+	= "ocaml_java__call_blocking_array"
+external call_blocking_array_opt : _ obj -> meth -> 'a jarray option
+	= "ocaml_java__call_blocking_array_opt"
+
+external call_static_blocking_void : jclass -> meth_static -> unit
+	= "ocaml_java__call_static_blocking_void"
+external call_static_blocking_int : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_blocking_int" "ocaml_java__call_static_blocking_int_unboxed"
+external call_static_blocking_bool : jclass -> meth_static -> bool
+	= "ocaml_java__call_static_blocking_bool"
+external call_static_blocking_byte : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_blocking_byte" "ocaml_java__call_static_blocking_byte_unboxed"
+external call_static_blocking_short : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_blocking_short" "ocaml_java__call_static_blocking_short_unboxed"
+external call_static_blocking_int32 : jclass -> meth_static -> (int32 [@unboxed])
+	= "ocaml_java__call_static_blocking_int32" "ocaml_java__call_static_blocking_int32_unboxed"
+external call_static_blocking_long : jclass -> meth_static -> (int64 [@unboxed])
+	= "ocaml_java__call_static_blocking_long" "ocaml_java__call_static_blocking_long_unboxed"
+external call_static_blocking_char : jclass -> meth_static -> char
+	= "ocaml_java__call_static_blocking_char"
+external call_static_blocking_float : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_blocking_float" "ocaml_java__call_static_blocking_float_unboxed"
+external call_static_blocking_double : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_blocking_double" "ocaml_java__call_static_blocking_double_unboxed"
+external call_static_blocking_string : jclass -> meth_static -> string
+	= "ocaml_java__call_static_blocking_string"
+external call_static_blocking_string_opt : jclass -> meth_static -> string option
+	= "ocaml_java__call_static_blocking_string_opt"
+external call_static_blocking_object : jclass -> meth_static -> _ obj
+	= "ocaml_java__call_static_blocking_object"
+external call_static_blocking_value : jclass -> meth_static -> 'a
+	= "ocaml_java__call_static_blocking_value"
+external call_static_blocking_value_opt : jclass -> meth_static -> 'a option
+	= "ocaml_java__call_static_blocking_value_opt"
+external call_static_blocking_array : jclass -> meth_static -> 'a jarray
+	= "ocaml_java__call_static_blocking_array"
+external call_static_blocking_array_opt : jclass -> meth_static -> 'a jarray option
+	= "ocaml_java__call_static_blocking_array_opt"
+
+external call_void_i : _ obj -> meth -> int -> unit
+	= "ocaml_java__call_void_i"
+external call_int_i : _ obj -> meth -> int -> int
+	= "ocaml_java__call_int_i"
+external call_bool_i : _ obj -> meth -> int -> bool
+	= "ocaml_java__call_bool_i"
+external call_object_i : _ obj -> meth -> int -> _ obj
+	= "ocaml_java__call_object_i"
+external call_string_i : _ obj -> meth -> int -> string
+	= "ocaml_java__call_string_i"
+external call_void_o : _ obj -> meth -> _ obj -> unit
+	= "ocaml_java__call_void_o"
+external call_int_o : _ obj -> meth -> _ obj -> int
+	= "ocaml_java__call_int_o"
+external call_bool_o : _ obj -> meth -> _ obj -> bool
+	= "ocaml_java__call_bool_o"
+external call_object_o : _ obj -> meth -> _ obj -> _ obj
+	= "ocaml_java__call_object_o"
+external call_string_o : _ obj -> meth -> _ obj -> string
+	= "ocaml_java__call_string_o"
+external call_void_ii : _ obj -> meth -> int -> int -> unit
+	= "ocaml_java__call_void_ii"
+external call_int_ii : _ obj -> meth -> int -> int -> int
+	= "ocaml_java__call_int_ii"
+external call_bool_ii : _ obj -> meth -> int -> int -> bool
+	= "ocaml_java__call_bool_ii"
+external call_object_ii : _ obj -> meth -> int -> int -> _ obj
+	= "ocaml_java__call_object_ii"
+external call_string_ii : _ obj -> meth -> int -> int -> string
+	= "ocaml_java__call_string_ii"
+external call_void_io : _ obj -> meth -> int -> _ obj -> unit
+	= "ocaml_java__call_void_io"
+external call_int_io : _ obj -> meth -> int -> _ obj -> int
+	= "ocaml_java__call_int_io"
+external call_bool_io : _ obj -> meth -> int -> _ obj -> bool
+	= "ocaml_java__call_bool_io"
+external call_object_io : _ obj -> meth -> int -> _ obj -> _ obj
+	= "ocaml_java__call_object_io"
+external call_string_io : _ obj -> meth -> int -> _ obj -> string
+	= "ocaml_java__call_string_io"
+external call_void_oi : _ obj -> meth -> _ obj -> int -> unit
+	= "ocaml_java__call_void_oi"
+external call_int_oi : _ obj -> meth -> _ obj -> int -> int
+	= "ocaml_java__call_int_oi"
+external call_bool_oi : _ obj -> meth -> _ obj -> int -> bool
+	= "ocaml_java__call_bool_oi"
+external call_object_oi : _ obj -> meth -> _ obj -> int -> _ obj
+	= "ocaml_java__call_object_oi"
+external call_string_oi : _ obj -> meth -> _ obj -> int -> string
+	= "ocaml_java__call_string_oi"
+external call_void_oo : _ obj -> meth -> _ obj -> _ obj -> unit
+	= "ocaml_java__call_void_oo"
+external call_int_oo : _ obj -> meth -> _ obj -> _ obj -> int
+	= "ocaml_java__call_int_oo"
+external call_bool_oo : _ obj -> meth -> _ obj -> _ obj -> bool
+	= "ocaml_java__call_bool_oo"
+external call_object_oo : _ obj -> meth -> _ obj -> _ obj -> _ obj
+	= "ocaml_java__call_object_oo"
+external call_string_oo : _ obj -> meth -> _ obj -> _ obj -> string
+	= "ocaml_java__call_string_oo"
+
+external call_static_void_i : jclass -> meth_static -> int -> unit
+	= "ocaml_java__call_static_void_i"
+external call_static_int_i : jclass -> meth_static -> int -> int
+	= "ocaml_java__call_static_int_i"
+external call_static_bool_i : jclass -> meth_static -> int -> bool
+	= "ocaml_java__call_static_bool_i"
+external call_static_object_i : jclass -> meth_static -> int -> _ obj
+	= "ocaml_java__call_static_object_i"
+external call_static_string_i : jclass -> meth_static -> int -> string
+	= "ocaml_java__call_static_string_i"
+external call_static_void_o : jclass -> meth_static -> _ obj -> unit
+	= "ocaml_java__call_static_void_o"
+external call_static_int_o : jclass -> meth_static -> _ obj -> int
+	= "ocaml_java__call_static_int_o"
+external call_static_bool_o : jclass -> meth_static -> _ obj -> bool
+	= "ocaml_java__call_static_bool_o"
+external call_static_object_o : jclass -> meth_static -> _ obj -> _ obj
+	= "ocaml_java__call_static_object_o"
+external call_static_string_o : jclass -> meth_static -> _ obj -> string
+	= "ocaml_java__call_static_string_o"
+external call_static_void_ii : jclass -> meth_static -> int -> int -> unit
+	= "ocaml_java__call_static_void_ii"
+external call_static_int_ii : jclass -> meth_static -> int -> int -> int
+	= "ocaml_java__call_static_int_ii"
+external call_static_bool_ii : jclass -> meth_static -> int -> int -> bool
+	= "ocaml_java__call_static_bool_ii"
+external call_static_object_ii : jclass -> meth_static -> int -> int -> _ obj
+	= "ocaml_java__call_static_object_ii"
+external call_static_string_ii : jclass -> meth_static -> int -> int -> string
+	= "ocaml_java__call_static_string_ii"
+external call_static_void_io : jclass -> meth_static -> int -> _ obj -> unit
+	= "ocaml_java__call_static_void_io"
+external call_static_int_io : jclass -> meth_static -> int -> _ obj -> int
+	= "ocaml_java__call_static_int_io"
+external call_static_bool_io : jclass -> meth_static -> int -> _ obj -> bool
+	= "ocaml_java__call_static_bool_io"
+external call_static_object_io : jclass -> meth_static -> int -> _ obj -> _ obj
+	= "ocaml_java__call_static_object_io"
+external call_static_string_io : jclass -> meth_static -> int -> _ obj -> string
+	= "ocaml_java__call_static_string_io"
+external call_static_void_oi : jclass -> meth_static -> _ obj -> int -> unit
+	= "ocaml_java__call_static_void_oi"
+external call_static_int_oi : jclass -> meth_static -> _ obj -> int -> int
+	= "ocaml_java__call_static_int_oi"
+external call_static_bool_oi : jclass -> meth_static -> _ obj -> int -> bool
+	= "ocaml_java__call_static_bool_oi"
+external call_static_object_oi : jclass -> meth_static -> _ obj -> int -> _ obj
+	= "ocaml_java__call_static_object_oi"
+external call_static_string_oi : jclass -> meth_static -> _ obj -> int -> string
+	= "ocaml_java__call_static_string_oi"
+external call_static_void_oo : jclass -> meth_static -> _ obj -> _ obj -> unit
+	= "ocaml_java__call_static_void_oo"
+external call_static_int_oo : jclass -> meth_static -> _ obj -> _ obj -> int
+	= "ocaml_java__call_static_int_oo"
+external call_static_bool_oo : jclass -> meth_static -> _ obj -> _ obj -> bool
+	= "ocaml_java__call_static_bool_oo"
+external call_static_object_oo : jclass -> meth_static -> _ obj -> _ obj -> _ obj
+	= "ocaml_java__call_static_object_oo"
+external call_static_string_oo : jclass -> meth_static -> _ obj -> _ obj -> string
+	= "ocaml_java__call_static_string_oo"
+
+external call_object_local : _ obj -> meth -> _ obj
+	= "ocaml_java__call_object_local"
+external call_static_object_local : jclass -> meth_static -> _ obj
+	= "ocaml_java__call_static_object_local"
+external call_nonvirtual_object_local : _ obj -> jclass -> meth -> _ obj
+	= "ocaml_java__call_nonvirtual_object_local"
+external read_field_object_local : _ obj -> field -> _ obj
+	= "ocaml_java__read_field_object_local"
+external read_field_static_object_local : jclass -> field_static -> _ obj
+	= "ocaml_java__read_field_static_object_local"
+
+external read_field_int : _ obj -> field -> (int [@untagged])
+	= "ocaml_java__read_field_int" "ocaml_java__read_field_int_unboxed"
 external read_field_bool : _ obj -> field -> bool
 	= "ocaml_java__read_field_bool"
-external read_field_byte : _ obj -> field -> int
-	= "ocaml_java__read_field_byte"
-external read_field_short : _ obj -> field -> int
-	= "ocaml_java__read_field_short"
-external read_field_int32 : _ obj -> field -> int32
-	= "ocaml_java__read_field_int32"
-external read_field_long : _ obj -> field -> int64
-	= "ocaml_java__read_field_long"
+external read_field_byte : _ obj -> field -> (int [@untagged])
+	= "ocaml_java__read_field_byte" "ocaml_java__read_field_byte_unboxed"
+external read_field_short : _ obj -> field -> (int [@untagged])
+	= "ocaml_java__read_field_short" "ocaml_java__read_field_short_unboxed"
+external read_field_int32 : _ obj -> field -> (int32 [@unboxed])
+	= "ocaml_java__read_field_int32" "ocaml_java__read_field_int32_unboxed"
+external read_field_long : _ obj -> field -> (int64 [@unboxed])
+	= "ocaml_java__read_field_long" "ocaml_java__read_field_long_unboxed"
 external read_field_char : _ obj -> field -> char
 	= "ocaml_java__read_field_char"
-external read_field_float : _ obj -> field -> float
-	= "ocaml_java__read_field_float"
-external read_field_double : _ obj -> field -> float
-	= "ocaml_java__read_field_double"
+external read_field_float : _ obj -> field -> (float [@unboxed])
+	= "ocaml_java__read_field_float" "ocaml_java__read_field_float_unboxed"
+external read_field_double : _ obj -> field -> (float [@unboxed])
+	= "ocaml_java__read_field_double" "ocaml_java__read_field_double_unboxed"
 external read_field_string : _ obj -> field -> string
 	= "ocaml_java__read_field_string"
 external read_field_string_opt : _ obj -> field -> string option
@@ -151,24 +366,24 @@ external read_field_array : _ obj -> field -> 'a jarray
 external read_field_array_opt : _ obj -> field -> 'a jarray option
 	= "ocaml_java__read_field_array_opt"
 
-external read_field_static_int : jclass -> field_static -> int
-	= "ocaml_java__read_field_static_int" [@@noalloc]
+external read_field_static_int : jclass -> field_static -> (int [@untagged])
+	= "ocaml_java__read_field_static_int" "ocaml_java__read_field_static_int_unboxed"
 external read_field_static_bool : jclass -> field_static -> bool
-	= "ocaml_java__read_field_static_bool" [@@noalloc]
-external read_field_static_byte : jclass -> field_static -> int
-	= "ocaml_java__read_field_static_byte" [@@noalloc]
-external read_field_static_short : jclass -> field_static -> int
-	= "ocaml_java__read_field_static_short" [@@noalloc]
-external read_field_static_int32 : jclass -> field_static -> int32
-	= "ocaml_java__read_field_static_int32"
-external read_field_static_long : jclass -> field_static -> int64
-	= "ocaml_java__read_field_static_long"
+	= "ocaml_java__read_field_static_bool"
+external read_field_static_byte : jclass -> field_static -> (int [@untagged])
+	= "ocaml_java__read_field_static_byte" "ocaml_java__read_field_static_byte_unboxed"
+external read_field_static_short : jclass -> field_static -> (int [@untagged])
+	= "ocaml_java__read_field_static_short" "ocaml_java__read_field_static_short_unboxed"
+external read_field_static_int32 : jclass -> field_static -> (int32 [@unboxed])
+	= "ocaml_java__read_field_static_int32" "ocaml_java__read_field_static_int32_unboxed"
+external read_field_static_long : jclass -> field_static -> (int64 [@unboxed])
+	= "ocaml_java__read_field_static_long" "ocaml_java__read_field_static_long_unboxed"
 external read_field_static_char : jclass -> field_static -> char
-	= "ocaml_java__read_field_static_char" [@@noalloc]
-external read_field_static_float : jclass -> field_static -> float
-	= "ocaml_java__read_field_static_float"
-external read_field_static_double : jclass -> field_static -> float
-	= "ocaml_java__read_field_static_double"
+	= "ocaml_java__read_field_static_char"
+external read_field_static_float : jclass -> field_static -> (float [@unboxed])
+	= "ocaml_java__read_field_static_float" "ocaml_java__read_field_static_float_unboxed"
+external read_field_static_double : jclass -> field_static -> (float [@unboxed])
+	= "ocaml_java__read_field_static_double" "ocaml_java__read_field_static_double_unboxed"
 external read_field_static_string : jclass -> field_static -> string
 	= "ocaml_java__read_field_static_string"
 external read_field_static_string_opt : jclass -> field_static -> string option
@@ -184,24 +399,24 @@ external read_field_static_array : jclass -> field_static -> 'a jarray
 external read_field_static_array_opt : jclass -> field_static -> 'a jarray option
 	= "ocaml_java__read_field_static_array_opt"
 
-external write_field_int : _ obj -> field -> int -> unit
-	= "ocaml_java__write_field_int"
+external write_field_int : _ obj -> field -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_int" "ocaml_java__write_field_int_unboxed"
 external write_field_bool : _ obj -> field -> bool -> unit
 	= "ocaml_java__write_field_bool"
-external write_field_byte : _ obj -> field -> int -> unit
-	= "ocaml_java__write_field_byte"
-external write_field_short : _ obj -> field -> int -> unit
-	= "ocaml_java__write_field_short"
-external write_field_int32 : _ obj -> field -> int32 -> unit
-	= "ocaml_java__write_field_int32"
-external write_field_long : _ obj -> field -> int64 -> unit
-	= "ocaml_java__write_field_long"
+external write_field_byte : _ obj -> field -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_byte" "ocaml_java__write_field_byte_unboxed"
+external write_field_short : _ obj -> field -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_short" "ocaml_java__write_field_short_unboxed"
+external write_field_int32 : _ obj -> field -> (int32 [@unboxed]) -> unit
+	= "ocaml_java__write_field_int32" "ocaml_java__write_field_int32_unboxed"
+external write_field_long : _ obj -> field -> (int64 [@unboxed]) -> unit
+	= "ocaml_java__write_field_long" "ocaml_java__write_field_long_unboxed"
 external write_field_char : _ obj -> field -> char -> unit
 	= "ocaml_java__write_field_char"
-external write_field_float : _ obj -> field -> float -> unit
-	= "ocaml_java__write_field_float"
-external write_field_double : _ obj -> field -> float -> unit
-	= "ocaml_java__write_field_double"
+external write_field_float : _ obj -> field -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_float" "ocaml_java__write_field_float_unboxed"
+external write_field_double : _ obj -> field -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_double" "ocaml_java__write_field_double_unboxed"
 external write_field_string : _ obj -> field -> string -> unit
 	= "ocaml_java__write_field_string"
 external write_field_string_opt : _ obj -> field -> string option -> unit
@@ -217,35 +432,56 @@ external write_field_array : _ obj -> field -> 'a jarray -> unit
 external write_field_array_opt : _ obj -> field -> 'a jarray option -> unit
 	= "ocaml_java__write_field_array_opt"
 
-external write_field_static_int : jclass -> field_static -> int -> unit
-	= "ocaml_java__write_field_static_int" [@@noalloc]
+external write_field_static_int : jclass -> field_static -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_static_int" "ocaml_java__write_field_static_int_unboxed"
 external write_field_static_bool : jclass -> field_static -> bool -> unit
-	= "ocaml_java__write_field_static_bool" [@@noalloc]
-external write_field_static_byte : jclass -> field_static -> int -> unit
-	= "ocaml_java__write_field_static_byte" [@@noalloc]
-external write_field_static_short : jclass -> field_static -> int -> unit
-	= "ocaml_java__write_field_static_short" [@@noalloc]
-external write_field_static_int32 : jclass -> field_static -> int32 -> unit
-	= "ocaml_java__write_field_static_int32" [@@noalloc]
-external write_field_static_long : jclass -> field_static -> int64 -> unit
-	= "ocaml_java__write_field_static_long" [@@noalloc]
+	= "ocaml_java__write_field_static_bool"
+external write_field_static_byte : jclass -> field_static -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_static_byte" "ocaml_java__write_field_static_byte_unboxed"
+external write_field_static_short : jclass -> field_static -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_static_short" "ocaml_java__write_field_static_short_unboxed"
+external write_field_static_int32 : jclass -> field_static -> (int32 [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_int32" "ocaml_java__write_field_static_int32_unboxed"
+external write_field_static_long : jclass -> field_static -> (int64 [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_long" "ocaml_java__write_field_static_long_unboxed"
 external write_field_static_char : jclass -> field_static -> char -> unit
-	= "ocaml_java__write_field_static_char" [@@noalloc]
-external write_field_static_float : jclass -> field_static -> float -> unit
-	= "ocaml_java__write_field_static_float" [@@noalloc]
-external write_field_static_double : jclass -> field_static -> float -> unit
-	= "ocaml_java__write_field_static_double" [@@noalloc]
+	= "ocaml_java__write_field_static_char"
+external write_field_static_float : jclass -> field_static -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_float" "ocaml_java__write_field_static_float_unboxed"
+external write_field_static_double : jclass -> field_static -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_double" "ocaml_java__write_field_static_double_unboxed"
 external write_field_static_string : jclass -> field_static -> string -> unit
-	= "ocaml_java__write_field_static_string" [@@noalloc]
+	= "ocaml_java__write_field_static_string"
 external write_field_static_string_opt : jclass -> field_static -> string option -> unit
-	= "ocaml_java__write_field_static_string_opt" [@@noalloc]
+	= "ocaml_java__write_field_static_string_opt"
 external write_field_static_object : jclass -> field_static -> _ obj -> unit
-	= "ocaml_java__write_field_static_object" [@@noalloc]
+	= "ocaml_java__write_field_static_object"
 external write_field_static_value : jclass -> field_static -> 'a -> unit
-	= "ocaml_java__write_field_static_value" [@@noalloc]
+	= "ocaml_java__write_field_static_value"
 external write_field_static_value_opt : jclass -> field_static -> 'a option -> unit
-	= "ocaml_java__write_field_static_value_opt" [@@noalloc]
+	= "ocaml_java__write_field_static_value_opt"
 external write_field_static_array : jclass -> field_static -> 'a jarray -> unit
-	= "ocaml_java__write_field_static_array" [@@noalloc]
+	= "ocaml_java__write_field_static_array"
 external write_field_static_array_opt : jclass -> field_static -> 'a jarray option -> unit
-	= "ocaml_java__write_field_static_array_opt" [@@noalloc]
+	= "ocaml_java__write_field_static_array_opt"
+
+external push_string_interned : string -> unit
+	= "ocaml_java__push_string_interned"
+external call_string_interned : _ obj -> meth -> string
+	= "ocaml_java__call_string_interned"
+external call_static_string_interned : jclass -> meth_static -> string
+	= "ocaml_java__call_static_string_interned"
+external call_nonvirtual_string_interned : _ obj -> jclass -> meth -> string
+	= "ocaml_java__call_nonvirtual_string_interned"
+external call_blocking_string_interned : _ obj -> meth -> string
+	= "ocaml_java__call_blocking_string_interned"
+external call_static_blocking_string_interned : jclass -> meth_static -> string
+	= "ocaml_java__call_static_blocking_string_interned"
+external read_field_string_interned : _ obj -> field -> string
+	= "ocaml_java__read_field_string_interned"
+external read_field_static_string_interned : jclass -> field_static -> string
+	= "ocaml_java__read_field_static_string_interned"
+external write_field_string_interned : _ obj -> field -> string -> unit
+	= "ocaml_java__write_field_string_interned"
+external write_field_static_string_interned : jclass -> field_static -> string -> unit
+	= "ocaml_java__write_field_static_string_interned"
@@ -5,6 +5,11 @@
 		- Query the method handle with Jclass.get_meth
 		- Push the arguments with the push_ functions
 		- Finally call the method with one of the call_ functions
+	The calling stack is local to each thread and has no size limit
+	Calls made while a Java method is running (eg. from a callback)
+		do not interfere with the arguments of the running call
+	Threads are attached to the JVM the first time they call Java
+		and detached when they exit
 	-
 	Convertions:
 	| Java type			| OCaml type
@@ -30,27 +35,32 @@ open Java
 open Jclass
 
 (** Adds an argument on the calling stack *)
-external push_int : int -> unit = "ocaml_java__push_int" [@@noalloc]
+external push_int : (int [@untagged]) -> unit
+	= "ocaml_java__push_int" "ocaml_java__push_int_unboxed" [@@noalloc]
 external push_bool : bool -> unit = "ocaml_java__push_bool" [@@noalloc]
-external push_byte : int -> unit = "ocaml_java__push_byte" [@@noalloc]
-external push_short : int -> unit = "ocaml_java__push_short" [@@noalloc]
-external push_int32 : int32 -> unit = "ocaml_java__push_int32" [@@noalloc]
-external push_long : int64 -> unit = "ocaml_java__push_long" [@@noalloc]
+external push_byte : (int [@untagged]) -> unit
+	= "ocaml_java__push_byte" "ocaml_java__push_byte_unboxed" [@@noalloc]
+external push_short : (int [@untagged]) -> unit
+	= "ocaml_java__push_short" "ocaml_java__push_short_unboxed" [@@noalloc]
+external push_int32 : (int32 [@unboxed]) -> unit
+	= "ocaml_java__push_int32" "ocaml_java__push_int32_unboxed" [@@noalloc]
+external push_long : (int64 [@unboxed]) -> unit
+	= "ocaml_java__push_long" "ocaml_java__push_long_unboxed" [@@noalloc]
 external push_char : char -> unit = "ocaml_java__push_char" [@@noalloc]
 external push_float : (float [@unboxed]) -> unit
 	= "ocaml_java__push_float" "ocaml_java__push_float_unboxed" [@@noalloc]
 external push_double : (float [@unboxed]) -> unit
 	= "ocaml_java__push_double" "ocaml_java__push_double_unboxed" [@@noalloc]
-external push_string : string -> unit = "ocaml_java__push_string" [@@noalloc]
+external push_string : string -> unit = "ocaml_java__push_string"
 external push_string_opt : string option -> unit
-	= "ocaml_java__push_string_opt" [@@noalloc]
-external push_object : 'a obj -> unit = "ocaml_java__push_object" [@@noalloc]
+	= "ocaml_java__push_string_opt"
+external push_object : 'a obj -> unit = "ocaml_java__push_object"
 external push_value : 'a -> unit = "ocaml_java__push_value" [@@noalloc]
 external push_value_opt : 'a option -> unit
 	= "ocaml_java__push_value_opt" [@@noalloc]
-external push_array : 'a jarray -> unit = "ocaml_java__push_array" [@@noalloc]
+external push_array : 'a jarray -> unit = "ocaml_java__push_array"
 external push_array_opt : 'a jarray option -> unit
-	= "ocaml_java__push_array_opt" [@@noalloc]
+	= "ocaml_java__push_array_opt"
 
 (** Instantiate a new object
 	Assume enough argument are in the calling stack (see `push`)
@@ -64,62 +74,325 @@ val new_ : jclass -> meth_constructor -> 'a obj
   [call_string] and [call_value] raise `Failure` if the result is null
 	Raises `Java.Exception` if the method throws a Java exception
 	May crash if some argument are missing or have the wrong representation *)
-val call_void : 'a obj -> meth -> unit
-val call_int : 'a obj -> meth -> int
-val call_bool : 'a obj -> meth -> bool
-val call_byte : 'a obj -> meth -> int
-val call_short : 'a obj -> meth -> int
-val call_int32 : 'a obj -> meth -> int32
-val call_long : 'a obj -> meth -> int64
-val call_char : 'a obj -> meth -> char
-val call_float : 'a obj -> meth -> float
-val call_double : 'a obj -> meth -> float
-val call_string : 'a obj -> meth -> string
-val call_string_opt : 'a obj -> meth -> string option
-val call_object : 'a obj -> meth -> 'b obj
-val call_value : 'a obj -> meth -> 'b
-val call_value_opt : 'a obj -> meth -> 'b option
-val call_array : 'a obj -> meth -> 'b jarray
-val call_array_opt : 'a obj -> meth -> 'b jarray option
+external call_void : 'a obj -> meth -> unit = "ocaml_java__call_void"
+external call_int : 'a obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_int" "ocaml_java__call_int_unboxed"
+external call_bool : 'a obj -> meth -> bool = "ocaml_java__call_bool"
+external call_byte : 'a obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_byte" "ocaml_java__call_byte_unboxed"
+external call_short : 'a obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_short" "ocaml_java__call_short_unboxed"
+external call_int32 : 'a obj -> meth -> (int32 [@unboxed])
+	= "ocaml_java__call_int32" "ocaml_java__call_int32_unboxed"
+external call_long : 'a obj -> meth -> (int64 [@unboxed])
+	= "ocaml_java__call_long" "ocaml_java__call_long_unboxed"
+external call_char : 'a obj -> meth -> char = "ocaml_java__call_char"
+external call_float : 'a obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_float" "ocaml_java__call_float_unboxed"
+external call_double : 'a obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_double" "ocaml_java__call_double_unboxed"
+external call_string : 'a obj -> meth -> string = "ocaml_java__call_string"
+external call_string_opt : 'a obj -> meth -> string option
+	= "ocaml_java__call_string_opt"
+external call_object : 'a obj -> meth -> 'b obj = "ocaml_java__call_object"
+external call_value : 'a obj -> meth -> 'b = "ocaml_java__call_value"
+external call_value_opt : 'a obj -> meth -> 'b option
+	= "ocaml_java__call_value_opt"
+external call_array : 'a obj -> meth -> 'b jarray = "ocaml_java__call_array"
+external call_array_opt : 'a obj -> meth -> 'b jarray option
+	= "ocaml_java__call_array_opt"
 
 (** Same as `call`, for static methods *)
-val call_static_void : jclass -> meth_static -> unit
-val call_static_int : jclass -> meth_static -> int
-val call_static_bool : jclass -> meth_static -> bool
-val call_static_byte : jclass -> meth_static -> int
-val call_static_short : jclass -> meth_static -> int
-val call_static_int32 : jclass -> meth_static -> int32
-val call_static_long : jclass -> meth_static -> int64
-val call_static_char : jclass -> meth_static -> char
-val call_static_float : jclass -> meth_static -> float
-val call_static_double : jclass -> meth_static -> float
-val call_static_string : jclass -> meth_static -> string
-val call_static_string_opt : jclass -> meth_static -> string option
-val call_static_object : jclass -> meth_static -> 'a obj
-val call_static_value : jclass -> meth_static -> 'a
-val call_static_value_opt : jclass -> meth_static -> 'a option
-val call_static_array : jclass -> meth_static -> 'a jarray
-val call_static_array_opt : jclass -> meth_static -> 'a jarray option
+external call_static_void : jclass -> meth_static -> unit
+	= "ocaml_java__call_static_void"
+external call_static_int : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_int" "ocaml_java__call_static_int_unboxed"
+external call_static_bool : jclass -> meth_static -> bool
+	= "ocaml_java__call_static_bool"
+external call_static_byte : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_byte" "ocaml_java__call_static_byte_unboxed"
+external call_static_short : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_short" "ocaml_java__call_static_short_unboxed"
+external call_static_int32 : jclass -> meth_static -> (int32 [@unboxed])
+	= "ocaml_java__call_static_int32" "ocaml_java__call_static_int32_unboxed"
+external call_static_long : jclass -> meth_static -> (int64 [@unboxed])
+	= "ocaml_java__call_static_long" "ocaml_java__call_static_long_unboxed"
+external call_static_char : jclass -> meth_static -> char
+	= "ocaml_java__call_static_char"
+external call_static_float : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_float" "ocaml_java__call_static_float_unboxed"
+external call_static_double : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_double" "ocaml_java__call_static_double_unboxed"
+external call_static_string : jclass -> meth_static -> string
+	= "ocaml_java__call_static_string"
+external call_static_string_opt : jclass -> meth_static -> string option
+	= "ocaml_java__call_static_string_opt"
+external call_static_object : jclass -> meth_static -> 'a obj
+	= "ocaml_java__call_static_object"
+external call_static_value : jclass -> meth_static -> 'a
+	= "ocaml_java__call_static_value"
+external call_static_value_opt : jclass -> meth_static -> 'a option
+	= "ocaml_java__call_static_value_opt"
+external call_static_array : jclass -> meth_static -> 'a jarray
+	= "ocaml_java__call_static_array"
+external call_static_array_opt : jclass -> meth_static -> 'a jarray option
+	= "ocaml_java__call_static_array_opt"
 
 (** Same as `call`, for non-virtual call
 	Call the method of a specific class instead of the class of the object *)
-val call_nonvirtual_void : 'a obj -> jclass -> meth -> unit
-val call_nonvirtual_int : 'a obj -> jclass -> meth -> int
-val call_nonvirtual_bool : 'a obj -> jclass -> meth -> bool
-val call_nonvirtual_byte : 'a obj -> jclass -> meth -> int
-val call_nonvirtual_short : 'a obj -> jclass -> meth -> int
-val call_nonvirtual_int32 : 'a obj -> jclass -> meth -> int32
-val call_nonvirtual_long : 'a obj -> jclass -> meth -> int64
-val call_nonvirtual_char : 'a obj -> jclass -> meth -> char
-val call_nonvirtual_float : 'a obj -> jclass -> meth -> float
-val call_nonvirtual_double : 'a obj -> jclass -> meth -> float
-val call_nonvirtual_string : 'a obj -> jclass -> meth -> string
-val call_nonvirtual_string_opt : 'a obj -> jclass -> meth -> string option
-val call_nonvirtual_object : 'a obj -> jclass -> meth -> 'b obj
-val call_nonvirtual_value : 'a obj -> jclass -> meth -> 'b
-val call_nonvirtual_value_opt : 'a obj -> jclass -> meth -> 'b option
-val call_nonvirtual_array : 'a obj -> jclass -> meth -> 'b jarray
-val call_nonvirtual_array_opt : 'a obj -> jclass -> meth -> 'b jarray option
+external call_nonvirtual_void : 'a obj -> jclass -> meth -> unit
+	= "ocaml_java__call_nonvirtual_void"
+external call_nonvirtual_int : 'a obj -> jclass -> meth -> (int [@untagged])
+	= "ocaml_java__call_nonvirtual_int" "ocaml_java__call_nonvirtual_int_unboxed"
+external call_nonvirtual_bool : 'a obj -> jclass -> meth -> bool
+	= "ocaml_java__call_nonvirtual_bool"
+external call_nonvirtual_byte : 'a obj -> jclass -> meth -> (int [@untagged])
+	= "ocaml_java__call_nonvirtual_byte" "ocaml_java__call_nonvirtual_byte_unboxed"
+external call_nonvirtual_short : 'a obj -> jclass -> meth -> (int [@untagged])
+	= "ocaml_java__call_nonvirtual_short" "ocaml_java__call_nonvirtual_short_unboxed"
+external call_nonvirtual_int32 : 'a obj -> jclass -> meth -> (int32 [@unboxed])
+	= "ocaml_java__call_nonvirtual_int32" "ocaml_java__call_nonvirtual_int32_unboxed"
+external call_nonvirtual_long : 'a obj -> jclass -> meth -> (int64 [@unboxed])
+	= "ocaml_java__call_nonvirtual_long" "ocaml_java__call_nonvirtual_long_unboxed"
+external call_nonvirtual_char : 'a obj -> jclass -> meth -> char
+	= "ocaml_java__call_nonvirtual_char"
+external call_nonvirtual_float : 'a obj -> jclass -> meth -> (float [@unboxed])
+	= "ocaml_java__call_nonvirtual_float" "ocaml_java__call_nonvirtual_float_unboxed"
+external call_nonvirtual_double : 'a obj -> jclass -> meth -> (float [@unboxed])
+	= "ocaml_java__call_nonvirtual_double" "ocaml_java__call_nonvirtual_double_unboxed"
+external call_nonvirtual_string : 'a obj -> jclass -> meth -> string
+	= "ocaml_java__call_nonvirtual_string"
+external call_nonvirtual_string_opt : 'a obj -> jclass -> meth -> string option
+	= "ocaml_java__call_nonvirtual_string_opt"
+external call_nonvirtual_object : 'a obj -> jclass -> meth -> 'b obj
+	= "ocaml_java__call_nonvirtual_object"
+external call_nonvirtual_value : 'a obj -> jclass -> meth -> 'b
+	= "ocaml_java__call_nonvirtual_value"
+external call_nonvirtual_value_opt : 'a obj -> jclass -> meth -> 'b option
+	= "ocaml_java__call_nonvirtual_value_opt"
+external call_nonvirtual_array : 'a obj -> jclass -> meth -> 'b jarray
+	= "ocaml_java__call_nonvirtual_array"
+external call_nonvirtual_array_opt : 'a obj -> jclass -> meth -> 'b jarray option
+	= "ocaml_java__call_nonvirtual_array_opt"
+
+(** Same as `call` and `call_static`
+	but other OCaml threads can run during the Java call
+	The OCaml runtime lock is released after the arguments are converted
+		and acquired again before the result is converted
+	Use for methods that may block (IO, locks, long computations)
+	The Java method cannot call back into OCaml, `Caml.call*` and
+		`Caml.invoke*` throw a `ThreadException` during the call *)
+external call_blocking_void : 'a obj -> meth -> unit
+	= "ocaml_java__call_blocking_void"
+external call_blocking_int : 'a obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_blocking_int" "ocaml_java__call_blocking_int_unboxed"
+external call_blocking_bool : 'a obj -> meth -> bool
+	= "ocaml_java__call_blocking_bool"
+external call_blocking_byte : 'a obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_blocking_byte" "ocaml_java__call_blocking_byte_unboxed"
+external call_blocking_short : 'a obj -> meth -> (int [@untagged])
+	= "ocaml_java__call_blocking_short" "ocaml_java__call_blocking_short_unboxed"
+external call_blocking_int32 : 'a obj -> meth -> (int32 [@unboxed])
+	= "ocaml_java__call_blocking_int32" "ocaml_java__call_blocking_int32_unboxed"
+external call_blocking_long : 'a obj -> meth -> (int64 [@unboxed])
+	= "ocaml_java__call_blocking_long" "ocaml_java__call_blocking_long_unboxed"
+external call_blocking_char : 'a obj -> meth -> char
+	= "ocaml_java__call_blocking_char"
+external call_blocking_float : 'a obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_blocking_float" "ocaml_java__call_blocking_float_unboxed"
+external call_blocking_double : 'a obj -> meth -> (float [@unboxed])
+	= "ocaml_java__call_blocking_double" "ocaml_java__call_blocking_double_unboxed"
+external call_blocking_string : 'a obj -> meth -> string
+	= "ocaml_java__call_blocking_string"
+external call_blocking_string_opt : 'a obj -> meth -> string option
+	= "ocaml_java__call_blocking_string_opt"
+external call_blocking_object : 'a obj -> meth -> 'b obj
+	= "ocaml_java__call_blocking_object"
+external call_blocking_value : 'a obj -> meth -> 'b
+	= "ocaml_java__call_blocking_value"
+external call_blocking_value_opt : 'a obj -> meth -> 'b option
+	= "ocaml_java__call_blocking_value_opt"
+external call_blocking_array : 'a obj -> meth -> 'b jarray
+	= "ocaml_java__call_blocking_array"
+external call_blocking_array_opt : 'a obj -> meth -> 'b jarray option
+	= "ocaml_java__call_blocking_array_opt"
+
+external call_static_blocking_void : jclass -> meth_static -> unit
+	= "ocaml_java__call_static_blocking_void"
+external call_static_blocking_int : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_blocking_int" "ocaml_java__call_static_blocking_int_unboxed"
+external call_static_blocking_bool : jclass -> meth_static -> bool
+	= "ocaml_java__call_static_blocking_bool"
+external call_static_blocking_byte : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_blocking_byte" "ocaml_java__call_static_blocking_byte_unboxed"
+external call_static_blocking_short : jclass -> meth_static -> (int [@untagged])
+	= "ocaml_java__call_static_blocking_short" "ocaml_java__call_static_blocking_short_unboxed"
+external call_static_blocking_int32 : jclass -> meth_static -> (int32 [@unboxed])
+	= "ocaml_java__call_static_blocking_int32" "ocaml_java__call_static_blocking_int32_unboxed"
+external call_static_blocking_long : jclass -> meth_static -> (int64 [@unboxed])
+	= "ocaml_java__call_static_blocking_long" "ocaml_java__call_static_blocking_long_unboxed"
+external call_static_blocking_char : jclass -> meth_static -> char
+	= "ocaml_java__call_static_blocking_char"
+external call_static_blocking_float : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_blocking_float" "ocaml_java__call_static_blocking_float_unboxed"
+external call_static_blocking_double : jclass -> meth_static -> (float [@unboxed])
+	= "ocaml_java__call_static_blocking_double" "ocaml_java__call_static_blocking_double_unboxed"
+external call_static_blocking_string : jclass -> meth_static -> string
+	= "ocaml_java__call_static_blocking_string"
+external call_static_blocking_string_opt : jclass -> meth_static -> string option
+	= "ocaml_java__call_static_blocking_string_opt"
+external call_static_blocking_object : jclass -> meth_static -> 'a obj
+	= "ocaml_java__call_static_blocking_object"
+external call_static_blocking_value : jclass -> meth_static -> 'a
+	= "ocaml_java__call_static_blocking_value"
+external call_static_blocking_value_opt : jclass -> meth_static -> 'a option
+	= "ocaml_java__call_static_blocking_value_opt"
+external call_static_blocking_array : jclass -> meth_static -> 'a jarray
+	= "ocaml_java__call_static_blocking_array"
+external call_static_blocking_array_opt : jclass -> meth_static -> 'a jarray option
+	= "ocaml_java__call_static_blocking_array_opt"
+
+(** Same as `call` and `call_static`
+	but the arguments are passed directly instead of using the calling stack
+	The suffix describes the arguments:
+		`i` for int and `o` for objects (may be null)
+	Defined for up to 2 arguments *)
+external call_void_i : 'a obj -> meth -> int -> unit
+	= "ocaml_java__call_void_i"
+external call_int_i : 'a obj -> meth -> int -> int
+	= "ocaml_java__call_int_i"
+external call_bool_i : 'a obj -> meth -> int -> bool
+	= "ocaml_java__call_bool_i"
+external call_object_i : 'a obj -> meth -> int -> 'b obj
+	= "ocaml_java__call_object_i"
+external call_string_i : 'a obj -> meth -> int -> string
+	= "ocaml_java__call_string_i"
+external call_void_o : 'a obj -> meth -> 'b obj -> unit
+	= "ocaml_java__call_void_o"
+external call_int_o : 'a obj -> meth -> 'b obj -> int
+	= "ocaml_java__call_int_o"
+external call_bool_o : 'a obj -> meth -> 'b obj -> bool
+	= "ocaml_java__call_bool_o"
+external call_object_o : 'a obj -> meth -> 'b obj -> 'c obj
+	= "ocaml_java__call_object_o"
+external call_string_o : 'a obj -> meth -> 'b obj -> string
+	= "ocaml_java__call_string_o"
+external call_void_ii : 'a obj -> meth -> int -> int -> unit
+	= "ocaml_java__call_void_ii"
+external call_int_ii : 'a obj -> meth -> int -> int -> int
+	= "ocaml_java__call_int_ii"
+external call_bool_ii : 'a obj -> meth -> int -> int -> bool
+	= "ocaml_java__call_bool_ii"
+external call_object_ii : 'a obj -> meth -> int -> int -> 'b obj
+	= "ocaml_java__call_object_ii"
+external call_string_ii : 'a obj -> meth -> int -> int -> string
+	= "ocaml_java__call_string_ii"
+external call_void_io : 'a obj -> meth -> int -> 'b obj -> unit
+	= "ocaml_java__call_void_io"
+external call_int_io : 'a obj -> meth -> int -> 'b obj -> int
+	= "ocaml_java__call_int_io"
+external call_bool_io : 'a obj -> meth -> int -> 'b obj -> bool
+	= "ocaml_java__call_bool_io"
+external call_object_io : 'a obj -> meth -> int -> 'b obj -> 'c obj
+	= "ocaml_java__call_object_io"
+external call_string_io : 'a obj -> meth -> int -> 'b obj -> string
+	= "ocaml_java__call_string_io"
+external call_void_oi : 'a obj -> meth -> 'b obj -> int -> unit
+	= "ocaml_java__call_void_oi"
+external call_int_oi : 'a obj -> meth -> 'b obj -> int -> int
+	= "ocaml_java__call_int_oi"
+external call_bool_oi : 'a obj -> meth -> 'b obj -> int -> bool
+	= "ocaml_java__call_bool_oi"
+external call_object_oi : 'a obj -> meth -> 'b obj -> int -> 'c obj
+	= "ocaml_java__call_object_oi"
+external call_string_oi : 'a obj -> meth -> 'b obj -> int -> string
+	= "ocaml_java__call_string_oi"
+external call_void_oo : 'a obj -> meth -> 'b obj -> 'c obj -> unit
+	= "ocaml_java__call_void_oo"
+external call_int_oo : 'a obj -> meth -> 'b obj -> 'c obj -> int
+	= "ocaml_java__call_int_oo"
+external call_bool_oo : 'a obj -> meth -> 'b obj -> 'c obj -> bool
+	= "ocaml_java__call_bool_oo"
+external call_object_oo : 'a obj -> meth -> 'b obj -> 'c obj -> 'd obj
+	= "ocaml_java__call_object_oo"
+external call_string_oo : 'a obj -> meth -> 'b obj -> 'c obj -> string
+	= "ocaml_java__call_string_oo"
+
+external call_static_void_i : jclass -> meth_static -> int -> unit
+	= "ocaml_java__call_static_void_i"
+external call_static_int_i : jclass -> meth_static -> int -> int
+	= "ocaml_java__call_static_int_i"
+external call_static_bool_i : jclass -> meth_static -> int -> bool
+	= "ocaml_java__call_static_bool_i"
+external call_static_object_i : jclass -> meth_static -> int -> 'a obj
+	= "ocaml_java__call_static_object_i"
+external call_static_string_i : jclass -> meth_static -> int -> string
+	= "ocaml_java__call_static_string_i"
+external call_static_void_o : jclass -> meth_static -> 'a obj -> unit
+	= "ocaml_java__call_static_void_o"
+external call_static_int_o : jclass -> meth_static -> 'a obj -> int
+	= "ocaml_java__call_static_int_o"
+external call_static_bool_o : jclass -> meth_static -> 'a obj -> bool
+	= "ocaml_java__call_static_bool_o"
+external call_static_object_o : jclass -> meth_static -> 'a obj -> 'b obj
+	= "ocaml_java__call_static_object_o"
+external call_static_string_o : jclass -> meth_static -> 'a obj -> string
+	= "ocaml_java__call_static_string_o"
+external call_static_void_ii : jclass -> meth_static -> int -> int -> unit
+	= "ocaml_java__call_static_void_ii"
+external call_static_int_ii : jclass -> meth_static -> int -> int -> int
+	= "ocaml_java__call_static_int_ii"
+external call_static_bool_ii : jclass -> meth_static -> int -> int -> bool
+	= "ocaml_java__call_static_bool_ii"
+external call_static_object_ii : jclass -> meth_static -> int -> int -> 'a obj
+	= "ocaml_java__call_static_object_ii"
+external call_static_string_ii : jclass -> meth_static -> int -> int -> string
+	= "ocaml_java__call_static_string_ii"
+external call_static_void_io : jclass -> meth_static -> int -> 'a obj -> unit
+	= "ocaml_java__call_static_void_io"
+external call_static_int_io : jclass -> meth_static -> int -> 'a obj -> int
+	= "ocaml_java__call_static_int_io"
+external call_static_bool_io : jclass -> meth_static -> int -> 'a obj -> bool
+	= "ocaml_java__call_static_bool_io"
+external call_static_object_io : jclass -> meth_static -> int -> 'a obj -> 'b obj
+	= "ocaml_java__call_static_object_io"
+external call_static_string_io : jclass -> meth_static -> int -> 'a obj -> string
+	= "ocaml_java__call_static_string_io"
+external call_static_void_oi : jclass -> meth_static -> 'a obj -> int -> unit
+	= "ocaml_java__call_static_void_oi"
+external call_static_int_oi : jclass -> meth_static -> 'a obj -> int -> int
+	= "ocaml_java__call_static_int_oi"
+external call_static_bool_oi : jclass -> meth_static -> 'a obj -> int -> bool
+	= "ocaml_java__call_static_bool_oi"
+external call_static_object_oi : jclass -> meth_static -> 'a obj -> int -> 'b obj
+	= "ocaml_java__call_static_object_oi"
+external call_static_string_oi : jclass -> meth_static -> 'a obj -> int -> string
+	= "ocaml_java__call_static_string_oi"
+external call_static_void_oo : jclass -> meth_static -> 'a obj -> 'b obj -> unit
+	= "ocaml_java__call_static_void_oo"
+external call_static_int_oo : jclass -> meth_static -> 'a obj -> 'b obj -> int
+	= "ocaml_java__call_static_int_oo"
+external call_static_bool_oo : jclass -> meth_static -> 'a obj -> 'b obj -> bool
+	= "ocaml_java__call_static_bool_oo"
+external call_static_object_oo : jclass -> meth_static -> 'a obj -> 'b obj -> 'c obj
+	= "ocaml_java__call_static_object_oo"
+external call_static_string_oo : jclass -> meth_static -> 'a obj -> 'b obj -> string
+	= "ocaml_java__call_static_string_oo"
+
+(** Same as `call_object`, `call_static_object`, `call_nonvirtual_object`,
+		`read_field_object` and `read_field_static_object`
+	but the result is a local object, see `Java.with_local_frame`
+	Outside of a local frame, they are the same as the non-local functions *)
+external call_object_local : 'a obj -> meth -> 'b obj
+	= "ocaml_java__call_object_local"
+external call_static_object_local : jclass -> meth_static -> 'a obj
+	= "ocaml_java__call_static_object_local"
+external call_nonvirtual_object_local : 'a obj -> jclass -> meth -> 'b obj
+	= "ocaml_java__call_nonvirtual_object_local"
+external read_field_object_local : 'a obj -> field -> 'b obj
+	= "ocaml_java__read_field_object_local"
+external read_field_static_object_local : jclass -> field_static -> 'a obj
+	= "ocaml_java__read_field_static_object_local"
 
 (** Unsafe interface for reading and writing Java fields *)
 
@@ -127,75 +400,162 @@ val call_nonvirtual_array_opt : 'a obj -> jclass -> meth -> 'b jarray option
   [read_field_string] and [read_field_value] raise `Failure`
     if the result is null
 	May crash if the representation is incorrect *)
-val read_field_int : 'a obj -> field -> int
-val read_field_bool : 'a obj -> field -> bool
-val read_field_byte : 'a obj -> field -> int
-val read_field_short : 'a obj -> field -> int
-val read_field_int32 : 'a obj -> field -> int32
-val read_field_long : 'a obj -> field -> int64
-val read_field_char : 'a obj -> field -> char
-val read_field_float : 'a obj -> field -> float
-val read_field_double : 'a obj -> field -> float
-val read_field_string : 'a obj -> field -> string
-val read_field_string_opt : 'a obj -> field -> string option
-val read_field_object : 'a obj -> field -> 'b obj
-val read_field_value : 'a obj -> field -> 'b
-val read_field_value_opt : 'a obj -> field -> 'b option
-val read_field_array : 'a obj -> field -> 'b jarray
-val read_field_array_opt : 'a obj -> field -> 'b jarray option
+external read_field_int : 'a obj -> field -> (int [@untagged])
+	= "ocaml_java__read_field_int" "ocaml_java__read_field_int_unboxed"
+external read_field_bool : 'a obj -> field -> bool
+	= "ocaml_java__read_field_bool"
+external read_field_byte : 'a obj -> field -> (int [@untagged])
+	= "ocaml_java__read_field_byte" "ocaml_java__read_field_byte_unboxed"
+external read_field_short : 'a obj -> field -> (int [@untagged])
+	= "ocaml_java__read_field_short" "ocaml_java__read_field_short_unboxed"
+external read_field_int32 : 'a obj -> field -> (int32 [@unboxed])
+	= "ocaml_java__read_field_int32" "ocaml_java__read_field_int32_unboxed"
+external read_field_long : 'a obj -> field -> (int64 [@unboxed])
+	= "ocaml_java__read_field_long" "ocaml_java__read_field_long_unboxed"
+external read_field_char : 'a obj -> field -> char
+	= "ocaml_java__read_field_char"
+external read_field_float : 'a obj -> field -> (float [@unboxed])
+	= "ocaml_java__read_field_float" "ocaml_java__read_field_float_unboxed"
+external read_field_double : 'a obj -> field -> (float [@unboxed])
+	= "ocaml_java__read_field_double" "ocaml_java__read_field_double_unboxed"
+external read_field_string : 'a obj -> field -> string
+	= "ocaml_java__read_field_string"
+external read_field_string_opt : 'a obj -> field -> string option
+	= "ocaml_java__read_field_string_opt"
+external read_field_object : 'a obj -> field -> 'b obj
+	= "ocaml_java__read_field_object"
+external read_field_value : 'a obj -> field -> 'b
+	= "ocaml_java__read_field_value"
+external read_field_value_opt : 'a obj -> field -> 'b option
+	= "ocaml_java__read_field_value_opt"
+external read_field_array : 'a obj -> field -> 'b jarray
+	= "ocaml_java__read_field_array"
+external read_field_array_opt : 'a obj -> field -> 'b jarray option
+	= "ocaml_java__read_field_array_opt"
 
 (** Same as `read_field`, for static fields
   [read_field_static_double] and [read_field_static_value] raise `Failure`
     if the result is null *)
-val read_field_static_int : jclass -> field_static -> int
-val read_field_static_bool : jclass -> field_static -> bool
-val read_field_static_byte : jclass -> field_static -> int
-val read_field_static_short : jclass -> field_static -> int
-val read_field_static_int32 : jclass -> field_static -> int32
-val read_field_static_long : jclass -> field_static -> int64
-val read_field_static_char : jclass -> field_static -> char
-val read_field_static_float : jclass -> field_static -> float
-val read_field_static_double : jclass -> field_static -> float
-val read_field_static_string : jclass -> field_static -> string
-val read_field_static_string_opt : jclass -> field_static -> string option
-val read_field_static_object : jclass -> field_static -> 'a obj
-val read_field_static_value : jclass -> field_static -> 'a
-val read_field_static_value_opt : jclass -> field_static -> 'a option
-val read_field_static_array : jclass -> field_static -> 'a jarray
-val read_field_static_array_opt : jclass -> field_static -> 'a jarray option
+external read_field_static_int : jclass -> field_static -> (int [@untagged])
+	= "ocaml_java__read_field_static_int" "ocaml_java__read_field_static_int_unboxed"
+external read_field_static_bool : jclass -> field_static -> bool
+	= "ocaml_java__read_field_static_bool"
+external read_field_static_byte : jclass -> field_static -> (int [@untagged])
+	= "ocaml_java__read_field_static_byte" "ocaml_java__read_field_static_byte_unboxed"
+external read_field_static_short : jclass -> field_static -> (int [@untagged])
+	= "ocaml_java__read_field_static_short" "ocaml_java__read_field_static_short_unboxed"
+external read_field_static_int32 : jclass -> field_static -> (int32 [@unboxed])
+	= "ocaml_java__read_field_static_int32" "ocaml_java__read_field_static_int32_unboxed"
+external read_field_static_long : jclass -> field_static -> (int64 [@unboxed])
+	= "ocaml_java__read_field_static_long" "ocaml_java__read_field_static_long_unboxed"
+external read_field_static_char : jclass -> field_static -> char
+	= "ocaml_java__read_field_static_char"
+external read_field_static_float : jclass -> field_static -> (float [@unboxed])
+	= "ocaml_java__read_field_static_float" "ocaml_java__read_field_static_float_unboxed"
+external read_field_static_double : jclass -> field_static -> (float [@unboxed])
+	= "ocaml_java__read_field_static_double" "ocaml_java__read_field_static_double_unboxed"
+external read_field_static_string : jclass -> field_static -> string
+	= "ocaml_java__read_field_static_string"
+external read_field_static_string_opt : jclass -> field_static -> string option
+	= "ocaml_java__read_field_static_string_opt"
+external read_field_static_object : jclass -> field_static -> 'a obj
+	= "ocaml_java__read_field_static_object"
+external read_field_static_value : jclass -> field_static -> 'a
+	= "ocaml_java__read_field_static_value"
+external read_field_static_value_opt : jclass -> field_static -> 'a option
+	= "ocaml_java__read_field_static_value_opt"
+external read_field_static_array : jclass -> field_static -> 'a jarray
+	= "ocaml_java__read_field_static_array"
+external read_field_static_array_opt : jclass -> field_static -> 'a jarray option
+	= "ocaml_java__read_field_static_array_opt"
 
 (** Write to a field *)
-val write_field_int : 'a obj -> field -> int -> unit
-val write_field_bool : 'a obj -> field -> bool -> unit
-val write_field_byte : 'a obj -> field -> int -> unit
-val write_field_short : 'a obj -> field -> int -> unit
-val write_field_int32 : 'a obj -> field -> int32 -> unit
-val write_field_long : 'a obj -> field -> int64 -> unit
-val write_field_char : 'a obj -> field -> char -> unit
-val write_field_float : 'a obj -> field -> float -> unit
-val write_field_double : 'a obj -> field -> float -> unit
-val write_field_string : 'a obj -> field -> string -> unit
-val write_field_string_opt : 'a obj -> field -> string option -> unit
-val write_field_object : 'a obj -> field -> 'b obj -> unit
-val write_field_value : 'a obj -> field -> 'b -> unit
-val write_field_value_opt : 'a obj -> field -> 'b option -> unit
-val write_field_array : 'a obj -> field -> 'b jarray -> unit
-val write_field_array_opt : 'a obj -> field -> 'b jarray option -> unit
+external write_field_int : 'a obj -> field -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_int" "ocaml_java__write_field_int_unboxed"
+external write_field_bool : 'a obj -> field -> bool -> unit
+	= "ocaml_java__write_field_bool"
+external write_field_byte : 'a obj -> field -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_byte" "ocaml_java__write_field_byte_unboxed"
+external write_field_short : 'a obj -> field -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_short" "ocaml_java__write_field_short_unboxed"
+external write_field_int32 : 'a obj -> field -> (int32 [@unboxed]) -> unit
+	= "ocaml_java__write_field_int32" "ocaml_java__write_field_int32_unboxed"
+external write_field_long : 'a obj -> field -> (int64 [@unboxed]) -> unit
+	= "ocaml_java__write_field_long" "ocaml_java__write_field_long_unboxed"
+external write_field_char : 'a obj -> field -> char -> unit
+	= "ocaml_java__write_field_char"
+external write_field_float : 'a obj -> field -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_float" "ocaml_java__write_field_float_unboxed"
+external write_field_double : 'a obj -> field -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_double" "ocaml_java__write_field_double_unboxed"
+external write_field_string : 'a obj -> field -> string -> unit
+	= "ocaml_java__write_field_string"
+external write_field_string_opt : 'a obj -> field -> string option -> unit
+	= "ocaml_java__write_field_string_opt"
+external write_field_object : 'a obj -> field -> 'b obj -> unit
+	= "ocaml_java__write_field_object"
+external write_field_value : 'a obj -> field -> 'b -> unit
+	= "ocaml_java__write_field_value"
+external write_field_value_opt : 'a obj -> field -> 'b option -> unit
+	= "ocaml_java__write_field_value_opt"
+external write_field_array : 'a obj -> field -> 'b jarray -> unit
+	= "ocaml_java__write_field_array"
+external write_field_array_opt : 'a obj -> field -> 'b jarray option -> unit
+	= "ocaml_java__write_field_array_opt"
 
 (** Same as `write_field`, for static fields *)
-val write_field_static_int : jclass -> field_static -> int -> unit
-val write_field_static_bool : jclass -> field_static -> bool -> unit
-val write_field_static_byte : jclass -> field_static -> int -> unit
-val write_field_static_short : jclass -> field_static -> int -> unit
-val write_field_static_int32 : jclass -> field_static -> int32 -> unit
-val write_field_static_long : jclass -> field_static -> int64 -> unit
-val write_field_static_char : jclass -> field_static -> char -> unit
-val write_field_static_float : jclass -> field_static -> float -> unit
-val write_field_static_double : jclass -> field_static -> float -> unit
-val write_field_static_string : jclass -> field_static -> string -> unit
-val write_field_static_string_opt : jclass -> field_static -> string option -> unit
-val write_field_static_object : jclass -> field_static -> 'a obj -> unit
-val write_field_static_value : jclass -> field_static -> 'a -> unit
-val write_field_static_value_opt : jclass -> field_static -> 'a option -> unit
-val write_field_static_array : jclass -> field_static -> 'a jarray -> unit
-val write_field_static_array_opt : jclass -> field_static -> 'a jarray option -> unit
+external write_field_static_int : jclass -> field_static -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_static_int" "ocaml_java__write_field_static_int_unboxed"
+external write_field_static_bool : jclass -> field_static -> bool -> unit
+	= "ocaml_java__write_field_static_bool"
+external write_field_static_byte : jclass -> field_static -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_static_byte" "ocaml_java__write_field_static_byte_unboxed"
+external write_field_static_short : jclass -> field_static -> (int [@untagged]) -> unit
+	= "ocaml_java__write_field_static_short" "ocaml_java__write_field_static_short_unboxed"
+external write_field_static_int32 : jclass -> field_static -> (int32 [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_int32" "ocaml_java__write_field_static_int32_unboxed"
+external write_field_static_long : jclass -> field_static -> (int64 [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_long" "ocaml_java__write_field_static_long_unboxed"
+external write_field_static_char : jclass -> field_static -> char -> unit
+	= "ocaml_java__write_field_static_char"
+external write_field_static_float : jclass -> field_static -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_float" "ocaml_java__write_field_static_float_unboxed"
+external write_field_static_double : jclass -> field_static -> (float [@unboxed]) -> unit
+	= "ocaml_java__write_field_static_double" "ocaml_java__write_field_static_double_unboxed"
+external write_field_static_string : jclass -> field_static -> string -> unit
+	= "ocaml_java__write_field_static_string"
+external write_field_static_string_opt : jclass -> field_static -> string option -> unit
+	= "ocaml_java__write_field_static_string_opt"
+external write_field_static_object : jclass -> field_static -> 'a obj -> unit
+	= "ocaml_java__write_field_static_object"
+external write_field_static_value : jclass -> field_static -> 'a -> unit
+	= "ocaml_java__write_field_static_value"
+external write_field_static_value_opt : jclass -> field_static -> 'a option -> unit
+	= "ocaml_java__write_field_static_value_opt"
+external write_field_static_array : jclass -> field_static -> 'a jarray -> unit
+	= "ocaml_java__write_field_static_array"
+external write_field_static_array_opt : jclass -> field_static -> 'a jarray option -> unit
+	= "ocaml_java__write_field_static_array_opt"
+
+(** Same as the `string` functions
+	but the strings go through the intern cache, see `Java.Intern` *)
+external push_string_interned : string -> unit
+	= "ocaml_java__push_string_interned"
+external call_string_interned : 'a obj -> meth -> string
+	= "ocaml_java__call_string_interned"
+external call_static_string_interned : jclass -> meth_static -> string
+	= "ocaml_java__call_static_string_interned"
+external call_nonvirtual_string_interned : 'a obj -> jclass -> meth -> string
+	= "ocaml_java__call_nonvirtual_string_interned"
+external call_blocking_string_interned : 'a obj -> meth -> string
+	= "ocaml_java__call_blocking_string_interned"
+external call_static_blocking_string_interned : jclass -> meth_static -> string
+	= "ocaml_java__call_static_blocking_string_interned"
+external read_field_string_interned : 'a obj -> field -> string
+	= "ocaml_java__read_field_string_interned"
+external read_field_static_string_interned : jclass -> field_static -> string
+	= "ocaml_java__read_field_static_string_interned"
+external write_field_string_interned : 'a obj -> field -> string -> unit
+	= "ocaml_java__write_field_string_interned"
+external write_field_static_string_interned : jclass -> field_static -> string -> unit
+	= "ocaml_java__write_field_static_string_interned"
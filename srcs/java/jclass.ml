@@ -24,6 +24,15 @@ external _get_field : t -> string -> string -> field
 external _get_field_static : t -> string -> string -> field_static
 	= "ocaml_java__class_get_field_static"
 
+type member =
+	| Meth of string * string
+	| Meth_static of string * string
+	| Field of string * string
+	| Field_static of string * string
+
+external _resolve_all : string -> member array -> t array
+	= "ocaml_java__class_resolve_all"
+
 let find_class name =
 	try _find_class name
 	with Not_found -> raise (Class_not_found name)
@@ -45,3 +54,16 @@ let get_field cls name sigt =
 let get_field_static cls name sigt =
 	try _get_field_static cls name sigt
 	with Not_found -> raise (Field_not_found (name, sigt))
+
+let resolve_all name members =
+	try _resolve_all name members
+	with Not_found ->
+		(* Slow path, find what is missing to raise the right exception *)
+		let cls = find_class name in
+		Array.iter (function
+			| Meth (n, sigt)			-> ignore (get_meth cls n sigt)
+			| Meth_static (n, sigt)		-> ignore (get_meth_static cls n sigt)
+			| Field (n, sigt)			-> ignore (get_field cls n sigt)
+			| Field_static (n, sigt)	-> ignore (get_field_static cls n sigt)
+		) members;
+		raise Not_found
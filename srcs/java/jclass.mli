@@ -19,7 +19,9 @@ val find_class : string -> t
 (** `get_meth cls name sgt` returns the method
 		named `name` with signature `sgt`
 	Raises `Method_not_found`
-		if the method does not exists with this signature *)
+		if the method does not exists with this signature
+	The lookups that raise drop the arguments pushed for a pending call
+		(see `Jcall`) *)
 val get_meth : t -> string -> string -> meth
 
 (** Same as `get_meth`, for static methods *)
@@ -35,3 +37,20 @@ val get_field : t -> string -> string -> field
 
 (** Same as `get_field`, for static fields *)
 val get_field_static : t -> string -> string -> field_static
+
+(** Describes a member of a class for `resolve_all`
+	The parameters are the name and the signature
+	Constructors are `Meth ("<init>", sgt)` *)
+type member =
+	| Meth of string * string
+	| Meth_static of string * string
+	| Field of string * string
+	| Field_static of string * string
+
+(** `resolve_all name members` finds the class `name`
+		and all the `members` in one call
+	Returns an array with the class at index 0 and the member `i`
+		(a `meth`, `meth_static`, `field` or `field_static`) at index `i + 1`
+	Used by the ppx's `[@java.eager]` mode
+	Raises `Class_not_found`, `Method_not_found` or `Field_not_found` *)
+val resolve_all : string -> member array -> t array
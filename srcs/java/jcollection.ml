@@ -0,0 +1,76 @@
+type 'a kind = int
+
+let obj = 0
+let string = 1
+let int = 2
+let float = 3
+
+external iterator : _ Java.obj -> _ Java.obj
+	= "ocaml_java__jcollection_iterator"
+external next : _ Java.obj -> int -> 'a kind -> 'a array
+	= "ocaml_java__jcollection_next"
+external next_entries :
+	_ Java.obj -> int -> 'a kind -> 'b kind -> 'a array * 'b array
+	= "ocaml_java__jcollection_next_entries"
+
+let chunk_size = 256
+
+let rec iter_chunks next f =
+	let chunk = next () in
+	if Array.length chunk > 0 then begin
+		f chunk;
+		iter_chunks next f
+	end
+
+let iter kind f coll =
+	let it = iterator coll in
+	iter_chunks (fun () -> next it chunk_size kind) (Array.iter f)
+
+let to_seq kind coll =
+	let it = iterator coll in
+	let rec seq chunk i () =
+		if i < Array.length chunk then
+			Seq.Cons (chunk.(i), seq chunk (i + 1))
+		else
+			let chunk = next it chunk_size kind in
+			if Array.length chunk = 0 then Seq.Nil
+			else seq chunk 0 ()
+	in
+	seq [||] 0
+
+let to_array kind coll =
+	let it = iterator coll in
+	let chunks = ref [] in
+	iter_chunks (fun () -> next it chunk_size kind)
+		(fun chunk -> chunks := chunk :: !chunks);
+	Array.concat (List.rev !chunks)
+
+let to_list kind coll = Array.to_list (to_array kind coll)
+
+let iter_map key_kind value_kind f map =
+	let it = iterator map in
+	let rec loop () =
+		let keys, values = next_entries it chunk_size key_kind value_kind in
+		if Array.length keys > 0 then begin
+			Array.iteri (fun i k -> f k values.(i)) keys;
+			loop ()
+		end
+	in
+	loop ()
+
+let map_to_seq key_kind value_kind map =
+	let it = iterator map in
+	let rec seq keys values i () =
+		if i < Array.length keys then
+			Seq.Cons ((keys.(i), values.(i)), seq keys values (i + 1))
+		else
+			let keys, values = next_entries it chunk_size key_kind value_kind in
+			if Array.length keys = 0 then Seq.Nil
+			else seq keys values 0 ()
+	in
+	seq [||] [||] 0
+
+let to_hashtbl key_kind value_kind map =
+	let tbl = Hashtbl.create 16 in
+	iter_map key_kind value_kind (Hashtbl.replace tbl) map;
+	tbl
@@ -0,0 +1,47 @@
+(** Reading Java collections
+	The elements are read by chunks, each chunk is converted in a single call
+	A collection is an `Iterator`, an `Iterable` (eg. a `List`),
+		a `Map` (its entries) or an array of objects
+	Functions taking a collection raise `Java.Exception`
+		if the object is not a collection
+		or if the elements have the wrong type *)
+
+(** Conversion of the elements *)
+type 'a kind
+
+(** Any object, `null` elements are `Java.null` *)
+val obj : 'a Java.obj kind
+
+(** `String` elements, raises `Failure` on `null` elements *)
+val string : string kind
+
+(** `Number` elements (eg. `Integer`, `Long`), converted with `longValue`
+	Values that do not fit in an OCaml int are truncated *)
+val int : int kind
+
+(** `Number` elements (eg. `Double`), converted with `doubleValue` *)
+val float : float kind
+
+(** `iter kind f coll` Calls `f` on each element *)
+val iter : 'a kind -> ('a -> unit) -> 'b Java.obj -> unit
+
+(** Iterates over a collection lazily
+	The sequence is ephemeral: it reads from the same Java `Iterator`
+		and can be traversed only once *)
+val to_seq : 'a kind -> 'b Java.obj -> 'a Seq.t
+
+(** Copies the elements of a collection *)
+val to_array : 'a kind -> 'b Java.obj -> 'a array
+val to_list : 'a kind -> 'b Java.obj -> 'a list
+
+(** `iter_map key_kind value_kind f map`
+	Calls `f` on each entry of a `Map` *)
+val iter_map : 'a kind -> 'b kind -> ('a -> 'b -> unit) -> 'c Java.obj -> unit
+
+(** Same as `to_seq` for the entries of a `Map` *)
+val map_to_seq : 'a kind -> 'b kind -> 'c Java.obj -> ('a * 'b) Seq.t
+
+(** Copies the entries of a `Map` into a new Hashtbl
+	`obj` keys are hashed and compared by calling `hashCode` and `compareTo`,
+		`string` and `int` keys should be prefered *)
+val to_hashtbl : 'a kind -> 'b kind -> 'c Java.obj -> ('a, 'b) Hashtbl.t
@@ -0,0 +1,40 @@
+type t = {
+	obj		: unit Java.obj;
+	fd		: Unix.file_descr
+}
+
+external create_ : unit -> unit Java.obj * Unix.file_descr
+	= "ocaml_java__jexecutor_create"
+
+external run_ : unit Java.obj -> Unix.file_descr -> int -> int
+	= "ocaml_java__jexecutor_run"
+
+external wait_ : Unix.file_descr -> unit = "ocaml_java__jexecutor_wait"
+
+external obj_cast : unit Java.obj -> 'a Java.obj = "%identity"
+
+let create () =
+	let obj, fd = create_ () in
+	{ obj; fd }
+
+let to_obj t = obj_cast t.obj
+
+let fd t = t.fd
+
+let run ?(max=64) t = run_ t.obj t.fd max
+
+let wait t = wait_ t.fd
+
+let loop t =
+	let executor = Jclass.find_class "java/util/concurrent/ExecutorService" in
+	let is_terminated = Jclass.get_meth executor "isTerminated" "()Z" in
+	let rec loop () =
+		if run t = 0 then begin
+			if not (Jcall.call_bool t.obj is_terminated) then begin
+				wait t;
+				loop ()
+			end
+		end else
+			loop ()
+	in
+	loop ()
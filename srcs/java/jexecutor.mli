@@ -0,0 +1,35 @@
+(** An `ExecutorService` whose tasks run on the OCaml thread
+	Java threads cannot call OCaml functions directly (`ThreadException`),
+		they can instead submit tasks to the executor
+	The tasks are queued, the OCaml side is woken up through a pipe
+		and runs them by batches with `run` *)
+type t
+
+(** Create a new executor
+	The pipe is not closed, an executor should live as long as the program *)
+val create : unit -> t
+
+(** The executor, an instance of `java.util.concurrent.ExecutorService` *)
+val to_obj : t -> 'a Java.obj
+
+(** A file descriptor that is readable when tasks are pending
+	Can be used to integrate the executor with an event loop
+	Don't read from it, `run` empties it *)
+val fd : t -> Unix.file_descr
+
+(** Runs the pending tasks, at most `max` (default: 64)
+	Returns the number of tasks run
+	If more tasks are pending, `fd` stays readable
+	The result of a task submitted with `submit` completes
+		the `CompletableFuture` returned by `submit`,
+		the exceptions of the other tasks are passed to the uncaught
+		exception handler of the thread *)
+val run : ?max:int -> t -> int
+
+(** Blocks until tasks are pending
+	Releases the runtime lock, other OCaml threads can run meanwhile *)
+val wait : t -> unit
+
+(** Runs the tasks until `shutdown` is called on the executor
+	and all the tasks have run *)
+val loop : t -> unit
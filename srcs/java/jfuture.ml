@@ -0,0 +1,96 @@
+type 'a t = 'a Java.obj
+
+type 'a outcome = ('a Java.obj, Java.jthrowable) result
+
+external to_throwable : _ Java.obj -> Java.jthrowable = "%identity"
+external of_obj_unsafe : _ Java.obj -> 'a t = "%identity"
+external to_obj : 'a t -> _ Java.obj = "%identity"
+
+type api = {
+	future : Jclass.t;
+	is_done : Jclass.meth;
+	get : Jclass.meth;
+	futures : Jclass.t;
+	on_complete : Jclass.meth_static;
+	execution_exception : Jclass.t;
+	get_cause : Jclass.meth;
+	completable : Jclass.t;
+	create : Jclass.meth_constructor;
+	complete : Jclass.meth;
+	complete_exceptionally : Jclass.meth
+}
+
+let api = lazy (
+	let future = Jclass.find_class "java/util/concurrent/Future" in
+	let futures = Jclass.find_class "juloo/javacaml/Futures" in
+	let completable =
+		Jclass.find_class "java/util/concurrent/CompletableFuture" in
+	let execution_exception =
+		Jclass.find_class "java/util/concurrent/ExecutionException" in
+	{
+		future;
+		is_done = Jclass.get_meth future "isDone" "()Z";
+		get = Jclass.get_meth future "get" "()Ljava/lang/Object;";
+		futures;
+		on_complete = Jclass.get_meth_static futures "onComplete"
+			"(Ljava/util/concurrent/Future;Ljava/util/concurrent/Executor;\
+			Ljava/lang/Runnable;)V";
+		execution_exception;
+		get_cause = Jclass.get_meth execution_exception "getCause"
+			"()Ljava/lang/Throwable;";
+		completable;
+		create = Jclass.get_constructor completable "()V";
+		complete = Jclass.get_meth completable "complete"
+			"(Ljava/lang/Object;)Z";
+		complete_exceptionally = Jclass.get_meth completable
+			"completeExceptionally" "(Ljava/lang/Throwable;)Z"
+	})
+
+let of_obj obj =
+	if not (Java.instanceof obj (Lazy.force api).future) then
+		failwith "Jfuture.of_obj";
+	of_obj_unsafe obj
+
+let is_done t = Jcall.call_bool t (Lazy.force api).is_done
+
+(* `t` must be done, `get` does not block
+	The cause of an `ExecutionException` is unwrapped *)
+let outcome t =
+	let api = Lazy.force api in
+	match Jcall.call_object t api.get with
+	| v								-> Ok v
+	| exception Java.Exception exn	->
+		let obj = Jthrowable.to_obj exn in
+		if not (Java.instanceof obj api.execution_exception) then Error exn
+		else
+			let cause = Jcall.call_object obj api.get_cause in
+			if cause == Java.null then Error exn else Error (to_throwable cause)
+
+let poll t = if is_done t then Some (outcome t) else None
+
+let on_complete executor t f =
+	let api = Lazy.force api in
+	let callback = Jrunnable.create (fun () -> f (outcome t)) in
+	Jcall.push_object t;
+	Jcall.push_object (Jexecutor.to_obj executor);
+	Jcall.push_object (Jrunnable.to_obj callback);
+	Jcall.call_static_void api.futures api.on_complete
+
+let create () =
+	let api = Lazy.force api in
+	Jcall.new_ api.completable api.create
+
+let complete t v =
+	Jcall.push_object v;
+	ignore (Jcall.call_bool t (Lazy.force api).complete)
+
+let fail t exn =
+	Jcall.push_object (Jthrowable.to_obj exn);
+	ignore (Jcall.call_bool t (Lazy.force api).complete_exceptionally)
+
+let of_deferred f =
+	let t = create () in
+	f (function
+		| Ok v		-> complete t v
+		| Error e	-> fail t e);
+	t
@@ -0,0 +1,53 @@
+(** Java futures (`java.util.concurrent.Future`)
+	The result of a future is a `'a Java.obj`
+	Completion is delivered on the OCaml thread through a `Jexecutor`,
+		no thread is blocked waiting for the result
+	Requires Java 8 *)
+type 'a t
+
+(** The result of a completed future
+	`Error` holds the exception that made the future fail
+		(not wrapped in an `ExecutionException`)
+		or the `CancellationException` if it was cancelled *)
+type 'a outcome = ('a Java.obj, Java.jthrowable) result
+
+(** Coerce from Java.obj
+	Raise `Failure` if the object is not an instance of Future or null *)
+val of_obj : 'b Java.obj -> 'a t
+
+(** Coerce to Java.obj *)
+val to_obj : 'a t -> 'b Java.obj
+
+(** Java to OCaml *)
+
+val is_done : 'a t -> bool
+
+(** Returns `None` if the future is not done, does not block *)
+val poll : 'a t -> 'a outcome option
+
+(** `on_complete executor t f`
+	Calls `f` when `t` completes, from `Jexecutor.run`
+	`f` is never called from `on_complete`,
+		even if the future is already done
+	Raises `Java.Exception` if the future is not a `CompletionStage`
+		(eg. a `CompletableFuture`) and is not done, use `poll` for those
+	Exceptions raised by `f` are passed to the uncaught exception handler
+		(see `Jexecutor.run`) *)
+val on_complete : Jexecutor.t -> 'a t -> ('a outcome -> unit) -> unit
+
+(** OCaml to Java *)
+
+(** Creates a new `CompletableFuture`, completed by `complete` or `fail`
+	Java code depending on it runs on the OCaml thread
+		when it is completed *)
+val create : unit -> 'a t
+
+(** Completes a future created with `create`
+	Does nothing if it is already completed *)
+val complete : 'a t -> 'a Java.obj -> unit
+val fail : 'a t -> Java.jthrowable -> unit
+
+(** `of_deferred f` Creates a `CompletableFuture`
+		and calls `f` with a function that completes it
+	That function can be called later, eg. from an event loop *)
+val of_deferred : (('a outcome -> unit) -> unit) -> 'a t
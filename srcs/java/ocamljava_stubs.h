@@ -0,0 +1,61 @@
+#ifndef OCAMLJAVA_STUBS_H
+# define OCAMLJAVA_STUBS_H
+
+#include <jni.h>
+
+#include <caml/alloc.h>
+#include <caml/memory.h>
+#include <caml/mlvalues.h>
+
+/*
+** ========================================================================== **
+** Stubs API
+** -
+** Used by the C stubs that the ppx generates for the classes declared with
+** 		the `[@java.stubs]` attribute (see `ppx/stubs.ml`)
+** The generated code calls JNI directly, with the IDs stored in static
+** 		variables and resolved by the class's init stub
+** -
+** ocaml_java__env()				The env of the calling thread
+** 									Raises `Failure` if it cannot be attached
+** ocaml_java__env_noraise()		Same but aborts, for the noalloc stubs
+** ocaml_java__stub_enter()			Returns a mark for `ocaml_java__stub_leave`
+** ocaml_java__stub_leave(mark)		Deletes the local refs created since `mark`
+** 									and raises `Java.Exception` if the
+** 									Java code thrown an exception
+** ocaml_java__stub_null()			Raises `Failure`, for calls on `null`
+** ocaml_java__stub_obj(env, v, mark)	Returns the jobject of a `Java.obj`
+** 									or `NULL`, may create a local ref
+** 									Raises `Failure` for a local object used
+** 									outside of its frame, after deleting
+** 									the local refs created since `mark`
+** ocaml_java__stub_string(env, v)	Converts an OCaml string, creates a local ref
+** ocaml_java__stub_of_obj(env, o)	Allocates a `Java.obj`, deletes `o`
+** ocaml_java__stub_of_string(env, s)	Converts a Java string, deletes `s`
+** 									Raises `Failure` if `s` is `null`
+** ocaml_java__stub_class(env, name)		Returns a global ref to a class
+** ocaml_java__stub_method(env, cls, name, sig, is_static)
+** ocaml_java__stub_field(env, cls, name, sig, is_static)
+** 									Raise `Failure` if the class, method
+** 									or field does not exist
+*/
+
+JNIEnv		*ocaml_java__env(void);
+JNIEnv		*ocaml_java__env_noraise(void);
+
+int			ocaml_java__stub_enter(void);
+void		ocaml_java__stub_leave(int mark);
+void		ocaml_java__stub_null(void);
+
+jobject		ocaml_java__stub_obj(JNIEnv *env, value v, int mark);
+jstring		ocaml_java__stub_string(JNIEnv *env, value v);
+value		ocaml_java__stub_of_obj(JNIEnv *env, jobject obj);
+value		ocaml_java__stub_of_string(JNIEnv *env, jstring str);
+
+jclass		ocaml_java__stub_class(JNIEnv *env, char const *name);
+jmethodID	ocaml_java__stub_method(JNIEnv *env, jclass cls,
+				char const *name, char const *sig, int is_static);
+jfieldID	ocaml_java__stub_field(JNIEnv *env, jclass cls,
+				char const *name, char const *sig, int is_static);
+
+#endif
@@ -1,39 +1,52 @@
+#include "classes.h"
 #include "javacaml_utils.h"
 
+#include <caml/fail.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
 /*
 ** ========================================================================== **
 ** Convertion between OCaml strings and Java strings
 ** OCaml strings are treated as UTF-8 encoded strings
 ** Java strings as UTF-16 strings
+** -
+** The convertions are done in two passes: the first computes the exact
+** 		length of the result and the second writes it
+** Runs of ASCII chars are converted by blocks (SSE2 if available)
 */
 
 // Decode an UTF-8 character from `str`, put it in `dst`
-// Decoding errors will read a single char and return (-1)
+// `avail` is the number of bytes available in `str`
+// Decoding errors (and truncated characters)
+// 		will read a single char and return (-1)
 // Returns the next position in `str`
-static uint32_t		read_utf8(uint8_t const *str, uint32_t *dst)
+static uint32_t		read_utf8(uint8_t const *str, size_t avail, uint32_t *dst)
 {
 	if (str[0] < 0x80)
 	{
 		*dst = str[0];
 		return 1;
 	}
-	else if ((str[0] >> 5) == 0x06)
+	else if ((str[0] >> 5) == 0x06 && avail >= 2)
 	{
 		*dst =	((str[0] & 0x1F) <<  6)
 			|	((str[1] & 0x3F) <<  0);
 		return 2;
 	}
-	else if ((str[0] >> 4) == 0x0E)
+	else if ((str[0] >> 4) == 0x0E && avail >= 3)
 	{
 		*dst =	((str[0] & 0x0F) << 12)
 			|	((str[1] & 0x3F) <<  6)
 			|	((str[2] & 0x3F) <<  0);
 		return 3;
 	}
-	else if ((str[0] >> 3) == 0x1E)
+	else if ((str[0] >> 3) == 0x1E && avail >= 4)
 	{
 		*dst =	((str[0] & 0x07) << 18)
 			|	((str[1] & 0x3F) << 12)
@@ -48,8 +61,8 @@ static uint32_t		read_utf8(uint8_t const *str, uint32_t *dst)
 	}
 }
 
-// Write the UTF-8 representation of `c` in `dst`
-// Invalid unicode character be ignored (return 0)
+// Write the UTF-8 representation of an UTF-16 char in `dst`
+// Each UTF-16 char is encoded separately, surrogate pairs included
 // Returns the next position in `dst`
 static uint32_t		write_utf8(uint8_t *dst, uint32_t c)
 {
@@ -64,44 +77,23 @@ static uint32_t		write_utf8(uint8_t *dst, uint32_t c)
 		dst[1] = ((c >>  0) & 0x3F) | 0x80;
 		return 2;
 	}
-	else if (c < 0x010000)
+	else
 	{
 		dst[0] = ((c >> 12) & 0x0F) | 0xE0;
 		dst[1] = ((c >>  6) & 0x3F) | 0x80;
 		dst[2] = ((c >>  0) & 0x3F) | 0x80;
 		return 3;
 	}
-	else if (c < 0x110000)
-	{
-		dst[0] = ((c >> 18) & 0x07) | 0xF0;
-		dst[1] = ((c >> 12) & 0x3F) | 0x80;
-		dst[2] = ((c >>  6) & 0x3F) | 0x80;
-		dst[3] = ((c >>  0) & 0x3F) | 0x80;
-		return 4;
-	}
-	else
-	{
-		return 0;
-	}
 }
 
-// Decode an UTF-16 character from `str`, put it in `dst`
-// Returns the next position in `str` (in number of char, not byte)
-static uint32_t		read_utf16(uint16_t const *str, uint32_t *dst)
+// Same as `write_utf8` but only returns the length
+static uint32_t		utf8_length(uint32_t c)
 {
-	if ((str[0] >> 10) == 0xD800)
-	{
-		*dst = ((str[0] & 0x03FF) << 10) | (str[1] & 0x03FF);
-		return 2;
-	}
-	else
-	{
-		*dst = str[0];
-		return 1;
-	}
+	return 1 + (c >= 0x80) + (c >= 0x0800);
 }
 
 // Write the UTF-16 encoding of `c` in `dst`
+// Invalid unicode character are ignored (return 0)
 // Returns the next position in `dst`
 static uint32_t		write_utf16(uint16_t *dst, uint32_t c)
 {
@@ -122,58 +114,403 @@ static uint32_t		write_utf16(uint16_t *dst, uint32_t c)
 	}
 }
 
+// Same as `write_utf16` but only returns the length
+static uint32_t		utf16_length(uint32_t c)
+{
+	return (c < 0x010000) ? 1 : (c < 0x110000) ? 2 : 0;
+}
+
+/*
+** Blocks of ASCII chars
+** `utf8_ascii`/`utf16_ascii` return the number of leading ASCII chars
+** 		in the block at `src`, `UTF8_BLOCK`/`UTF16_BLOCK` if all are ASCII
+** 		(the portable versions only detect whole blocks)
+** `widen_block`/`narrow_block` convert a whole block of ASCII chars
+** `utf16_block_utf8_length` returns the UTF-8 length of an UTF-16 block
+*/
+
+#ifdef __SSE2__
+
+# define UTF8_BLOCK		16
+# define UTF16_BLOCK	8
+
+static inline uint32_t	utf8_ascii(uint8_t const *src)
+{
+	uint32_t const	mask =
+		_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)src));
+
+	return (mask == 0) ? UTF8_BLOCK : (uint32_t)__builtin_ctz(mask);
+}
+
+// The mask has 2 bits per char
+static inline uint32_t	utf16_ascii(jchar const *src)
+{
+	__m128i const	v = _mm_loadu_si128((__m128i const*)src);
+	__m128i const	high = _mm_and_si128(v, _mm_set1_epi16((short)0xFF80));
+	uint32_t const	mask =
+		~_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128()))
+		& 0xFFFF;
+
+	return (mask == 0) ? UTF16_BLOCK : (uint32_t)__builtin_ctz(mask) / 2;
+}
+
+static inline void		widen_block(jchar *dst, uint8_t const *src)
+{
+	__m128i const	v = _mm_loadu_si128((__m128i const*)src);
+	__m128i const	zero = _mm_setzero_si128();
+
+	_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(v, zero));
+	_mm_storeu_si128((__m128i*)(dst + 8), _mm_unpackhi_epi8(v, zero));
+}
+
+static inline void		narrow_block(uint8_t *dst, jchar const *src)
+{
+	__m128i const	v = _mm_loadu_si128((__m128i const*)src);
+
+	_mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(v, v));
+}
+
+// Each char takes 1 byte, plus 1 if >= 0x80, plus 1 if >= 0x800
+static inline uint32_t	utf16_block_utf8_length(jchar const *src)
+{
+	__m128i const	v = _mm_loadu_si128((__m128i const*)src);
+	__m128i const	zero = _mm_setzero_si128();
+	uint32_t const	lt_80 = _mm_movemask_epi8(_mm_cmpeq_epi16(
+				_mm_and_si128(v, _mm_set1_epi16((short)0xFF80)), zero));
+	uint32_t const	lt_800 = _mm_movemask_epi8(_mm_cmpeq_epi16(
+				_mm_and_si128(v, _mm_set1_epi16((short)0xF800)), zero));
+
+	return UTF16_BLOCK * 3
+		- (__builtin_popcount(lt_80) + __builtin_popcount(lt_800)) / 2;
+}
+
+#else
+
+# define UTF8_BLOCK		8
+# define UTF16_BLOCK	4
+
+static inline uint32_t	utf8_ascii(uint8_t const *src)
+{
+	uint64_t		w;
+
+	memcpy(&w, src, sizeof(w));
+	return ((w & 0x8080808080808080ull) == 0) ? UTF8_BLOCK : 0;
+}
+
+static inline uint32_t	utf16_ascii(jchar const *src)
+{
+	uint64_t		w;
+
+	memcpy(&w, src, sizeof(w));
+	return ((w & 0xFF80FF80FF80FF80ull) == 0) ? UTF16_BLOCK : 0;
+}
+
+static inline void		widen_block(jchar *dst, uint8_t const *src)
+{
+	uint32_t		i;
+
+	for (i = 0; i < UTF8_BLOCK; i++)
+		dst[i] = src[i];
+}
+
+static inline void		narrow_block(uint8_t *dst, jchar const *src)
+{
+	uint32_t		i;
+
+	for (i = 0; i < UTF16_BLOCK; i++)
+		dst[i] = src[i];
+}
+
+static inline uint32_t	utf16_block_utf8_length(jchar const *src)
+{
+	uint32_t		length;
+	uint32_t		i;
+
+	length = 0;
+	for (i = 0; i < UTF16_BLOCK; i++)
+		length += utf8_length(src[i]);
+	return length;
+}
+
+#endif
+
+/*
+** ========================================================================== **
+** Transcoding
+** The lengths are computed exactly the same way as the convertion
+** 		is done, the results can be allocated with the exact size
+*/
+
+// Returns the length of the UTF-16 encoding of [src, end)
+static size_t		utf8_to_utf16_length(uint8_t const *src, uint8_t const *end)
+{
+	size_t			length;
+	uint32_t		n;
+	uint32_t		c;
+
+	length = 0;
+	while (src < end)
+	{
+		if (end - src >= UTF8_BLOCK && (n = utf8_ascii(src)) > 0)
+		{
+			src += n;
+			length += n;
+			continue ;
+		}
+		src += read_utf8(src, end - src, &c);
+		length += utf16_length(c);
+	}
+	return length;
+}
+
 // UTF-8 to UTF-16
-// Allows overflow when calling read_utf8 because OCaml strings are 0-terminated
-static uint32_t		utf8_to_utf16(jchar *dst, char const *src, char const *end)
+// `dst` must have the size returned by `utf8_to_utf16_length`
+static void			utf8_to_utf16(jchar *dst, uint8_t const *src,
+						uint8_t const *end)
 {
-	jchar *const		begin = dst;
-	uint32_t			c;
+	uint32_t		n;
+	uint32_t		c;
 
 	while (src < end)
 	{
-		src += read_utf8((uint8_t const*)src, &c);
+		if (end - src >= UTF8_BLOCK && (n = utf8_ascii(src)) > 0)
+		{
+			if (n == UTF8_BLOCK)
+				widen_block(dst, src);
+			else
+				for (c = 0; c < n; c++)
+					dst[c] = src[c];
+			src += n;
+			dst += n;
+			continue ;
+		}
+		src += read_utf8(src, end - src, &c);
 		dst += write_utf16((uint16_t*)dst, c);
 	}
-	return (dst - begin);
+}
+
+// Returns the length of the UTF-8 encoding of [src, end)
+static size_t		utf16_to_utf8_length(jchar const *src, jchar const *end)
+{
+	size_t			length;
+
+	length = 0;
+	for (; end - src >= UTF16_BLOCK; src += UTF16_BLOCK)
+		length += utf16_block_utf8_length(src);
+	for (; src < end; src++)
+		length += utf8_length(*src);
+	return length;
 }
 
 // UTF-16 to UTF-8
-// May overflow on malformed strings
-static uint32_t		utf16_to_utf8(char *dst, jchar const *src, jchar const *end)
+// `dst` must have the size returned by `utf16_to_utf8_length`
+static void			utf16_to_utf8(uint8_t *dst, jchar const *src,
+						jchar const *end)
 {
-	char *const			begin = dst;
-	uint32_t			c;
+	uint32_t		n;
+	uint32_t		i;
 
 	while (src < end)
 	{
-		src += read_utf16((uint16_t const *)src, &c);
-		dst += write_utf8((uint8_t*)dst, c);
+		if (end - src >= UTF16_BLOCK && (n = utf16_ascii(src)) > 0)
+		{
+			if (n == UTF16_BLOCK)
+				narrow_block(dst, src);
+			else
+				for (i = 0; i < n; i++)
+					dst[i] = src[i];
+			src += n;
+			dst += n;
+			continue ;
+		}
+		dst += write_utf8(dst, *src);
+		src++;
 	}
-	return (dst - begin);
 }
 
+/*
+** ========================================================================== **
+** API
+** Short strings are copied on the stack, the others are accessed
+** 		with `GetStringCritical` (not while allocating on the OCaml heap,
+** 		which could run finalizers that call JNI)
+*/
+
+#define STACK_CHARS		256
+
 value ocaml_java__of_jstring(JNIEnv *env, jstring str)
 {
-	uint32_t const	length = (*env)->GetStringLength(env, str);
-	char			dst[length * 4];
+	jsize const		length = (*env)->GetStringLength(env, str);
+	jchar			buff[STACK_CHARS];
 	jchar const		*src;
-	uint32_t		dst_length;
+	size_t			dst_length;
 	value			result;
 
-	src = (*env)->GetStringChars(env, str, NULL);
-	dst_length = utf16_to_utf8(dst, src, src + length);
-	(*env)->ReleaseStringChars(env, str, src);
+	if (length <= STACK_CHARS)
+	{
+		(*env)->GetStringRegion(env, str, 0, length, buff);
+		result = caml_alloc_string(utf16_to_utf8_length(buff, buff + length));
+		utf16_to_utf8((uint8_t*)String_val(result), buff, buff + length);
+		return result;
+	}
+	src = (*env)->GetStringCritical(env, str, NULL);
+	if (src == NULL)
+		caml_raise_out_of_memory();
+	dst_length = utf16_to_utf8_length(src, src + length);
+	(*env)->ReleaseStringCritical(env, str, src);
 	result = caml_alloc_string(dst_length);
-	memcpy((char*)String_val(result), dst, dst_length);
+	src = (*env)->GetStringCritical(env, str, NULL);
+	if (src == NULL)
+		caml_raise_out_of_memory();
+	utf16_to_utf8((uint8_t*)String_val(result), src, src + length);
+	(*env)->ReleaseStringCritical(env, str, src);
 	return result;
 }
 
+// The OCaml string does not move: there is no allocation on the OCaml heap
 jstring ocaml_java__to_jstring(JNIEnv *env, value str)
 {
-	uint32_t const	length = caml_string_length(str);
-	jchar			dst[length];
-	uint32_t		dst_length;
+	uint8_t const *const	src = (uint8_t const*)String_val(str);
+	uint8_t const *const	end = src + caml_string_length(str);
+	size_t const			length = utf8_to_utf16_length(src, end);
+	jchar					buff[STACK_CHARS];
+	jchar					*dst;
+	jstring					result;
+
+	if (length <= STACK_CHARS)
+	{
+		utf8_to_utf16(buff, src, end);
+		return (*env)->NewString(env, buff, length);
+	}
+	dst = malloc(length * sizeof(jchar));
+	if (dst == NULL)
+		caml_raise_out_of_memory();
+	utf8_to_utf16(dst, src, end);
+	result = (*env)->NewString(env, dst, length);
+	free(dst);
+	return result;
+}
 
-	dst_length = utf8_to_utf16(dst, String_val(str), String_val(str) + length);
-	return (*env)->NewString(env, dst, dst_length);
+/*
+** ========================================================================== **
+** Arrays
+** All the strings are transcoded into a single buffer, the Java strings
+** 		are created or read by `juloo.javacaml.StringArrays`
+** 		(see `StringArrays.java`)
+*/
+
+// Returns a local ref to a new String[]
+// Raises `Out_of_memory` if the allocation fail
+jobjectArray ocaml_java__to_jstring_array(JNIEnv *env, value src)
+{
+	mlsize_t const	n = caml_array_length(src);
+	jint			*offsets;
+	jchar			*data;
+	jcharArray		jdata;
+	jintArray		joffsets;
+	jobjectArray	result;
+	mlsize_t		i;
+	uint8_t const	*s;
+
+	offsets = malloc((n + 1) * sizeof(jint));
+	if (offsets == NULL)
+		caml_raise_out_of_memory();
+	offsets[0] = 0;
+	for (i = 0; i < n; i++)
+	{
+		s = (uint8_t const*)String_val(Field(src, i));
+		offsets[i + 1] = offsets[i] + utf8_to_utf16_length(s,
+				s + caml_string_length(Field(src, i)));
+	}
+	data = malloc(offsets[n] * sizeof(jchar) + 1);
+	if (data == NULL)
+	{
+		free(offsets);
+		caml_raise_out_of_memory();
+	}
+	for (i = 0; i < n; i++)
+	{
+		s = (uint8_t const*)String_val(Field(src, i));
+		utf8_to_utf16(data + offsets[i], s,
+				s + caml_string_length(Field(src, i)));
+	}
+	jdata = (*env)->NewCharArray(env, offsets[n]);
+	joffsets = (*env)->NewIntArray(env, n + 1);
+	result = NULL;
+	if (jdata != NULL && joffsets != NULL)
+	{
+		(*env)->SetCharArrayRegion(env, jdata, 0, offsets[n], data);
+		(*env)->SetIntArrayRegion(env, joffsets, 0, n + 1, offsets);
+		result = (*env)->CallStaticObjectMethod(env, CLASS(StringArrays),
+				STATIC_METHOD(StringArrays, split), jdata, joffsets);
+	}
+	free(data);
+	free(offsets);
+	(*env)->DeleteLocalRef(env, jdata);
+	(*env)->DeleteLocalRef(env, joffsets);
+	if (result == NULL)
+	{
+		(*env)->ExceptionClear(env);
+		caml_raise_out_of_memory();
+	}
+	return result;
+}
+
+// Returns an OCaml string array, deletes `array`
+// Raises `Failure` if one of the strings is `null`
+value ocaml_java__of_jstring_array(JNIEnv *env, jobjectArray array)
+{
+	CAMLparam0();
+	CAMLlocal2(result, str);
+	jsize const		n = (*env)->GetArrayLength(env, array);
+	jintArray		joffsets;
+	jcharArray		jdata;
+	jint			*offsets;
+	jchar			*data;
+	jsize			i;
+
+	joffsets = (*env)->NewIntArray(env, n + 1);
+	if (joffsets == NULL)
+	{
+		(*env)->ExceptionClear(env);
+		(*env)->DeleteLocalRef(env, array);
+		caml_raise_out_of_memory();
+	}
+	jdata = (*env)->CallStaticObjectMethod(env, CLASS(StringArrays),
+			STATIC_METHOD(StringArrays, join), array, joffsets);
+	(*env)->DeleteLocalRef(env, array);
+	if ((*env)->ExceptionCheck(env))
+	{
+		(*env)->ExceptionClear(env);
+		(*env)->DeleteLocalRef(env, joffsets);
+		caml_failwith("Null string");
+	}
+	offsets = malloc((n + 1) * sizeof(jint));
+	data = NULL;
+	if (offsets != NULL)
+	{
+		(*env)->GetIntArrayRegion(env, joffsets, 0, n + 1, offsets);
+		data = malloc(offsets[n] * sizeof(jchar) + 1);
+		if (data != NULL)
+			(*env)->GetCharArrayRegion(env, jdata, 0, offsets[n], data);
+	}
+	(*env)->DeleteLocalRef(env, joffsets);
+	(*env)->DeleteLocalRef(env, jdata);
+	if (data == NULL)
+	{
+		free(offsets);
+		caml_raise_out_of_memory();
+	}
+	result = caml_alloc(n, 0);
+	for (i = 0; i < n; i++)
+	{
+		str = caml_alloc_string(utf16_to_utf8_length(data + offsets[i],
+					data + offsets[i + 1]));
+		utf16_to_utf8((uint8_t*)String_val(str), data + offsets[i],
+				data + offsets[i + 1]);
+		Store_field(result, i, str);
+	}
+	free(data);
+	free(offsets);
+	CAMLreturn(result);
 }
@@ -0,0 +1,42 @@
+package juloo.javacaml;
+
+import java.lang.ref.PhantomReference;
+import java.lang.ref.ReferenceQueue;
+import java.nio.ByteBuffer;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.Set;
+
+/**
+ * Keep an OCaml Bigarray alive while the direct ByteBuffer
+ *  that points to its data is reachable
+ * Created by `Jbuffer.of_bigarray`
+ * The owners of the collected buffers are released on the next `wrap`
+ */
+public class BufferValue extends PhantomReference<ByteBuffer>
+{
+	private static final ReferenceQueue<ByteBuffer> queue =
+		new ReferenceQueue<ByteBuffer>();
+	private static final Set<BufferValue> live =
+		Collections.synchronizedSet(new HashSet<BufferValue>());
+
+	private Value owner;
+
+	private BufferValue(ByteBuffer buffer, Value owner)
+	{
+		super(buffer, queue);
+		this.owner = owner;
+	}
+
+	protected static void wrap(ByteBuffer buffer, Value owner)
+	{
+		BufferValue r;
+
+		while ((r = (BufferValue)queue.poll()) != null)
+		{
+			live.remove(r);
+			r.owner = null;
+		}
+		live.add(new BufferValue(buffer, owner));
+	}
+}
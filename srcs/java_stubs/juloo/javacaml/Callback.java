@@ -6,6 +6,6 @@ package juloo.javacaml;
  */
 public class Callback
 {
-	private long closure;
+	final long closure;
 	private Callback(long c) { closure = c; }
 }
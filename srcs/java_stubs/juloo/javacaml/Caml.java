@@ -42,6 +42,20 @@ public class Caml
 	public static native int hashVariant(String variantName)
 		throws NullPointerException; // if `name` is null
 
+	/**
+	 * Resize the argument stack
+	 *
+	 * `maxDepth` is the maximum number of nested calls
+	 * `size` is the total number of slots shared by all the frames,
+	 *  a frame uses one slot for the function and one for each argument
+	 * The default is 64 nested calls and 512 slots
+	 *
+	 * The stack is allocated once, calls do not allocate
+	 */
+	public static native void setCallStackSize(int maxDepth, int size)
+		throws IllegalStateException, // if called during a call
+			IllegalArgumentException; // if `maxDepth` < 1 or `size` < `maxDepth`
+
 	/**
 	 * Begin the calling of a function
 	 *
@@ -56,11 +70,19 @@ public class Caml
 	 *  the result is a function taking the remaining arguments
 	 *
 	 * OCaml exception are handled and re-thrown on the Java side
+	 *
+	 * Calls can be nested: a new call can begin before the current one
+	 *  is performed (eg. to compute an argument)
+	 *  or from inside the function being called
+	 * Each call uses a new frame of the argument stack,
+	 *  see `setCallStackSize`
 	 */
 	public static native void function(Value function)
-		throws NullPointerException; // if `function` is null
+		throws NullPointerException, // if `function` is null
+			ArgumentStackOverflowException; // if the depth limit is reached
 	public static native void function(Callback callback)
-		throws NullPointerException; // if `callback` is null
+		throws NullPointerException, // if `callback` is null
+			ArgumentStackOverflowException; // if the depth limit is reached
 
 	/**
 	 * Begin the calling of a method
@@ -70,6 +92,7 @@ public class Caml
 	 */
 	public static native void method(Value object, int methodId)
 		throws NullPointerException, // if `object` is null
+			ArgumentStackOverflowException, // if the depth limit is reached
 			InvalidMethodIdException;
 				// if `methodId` does not refer to any object's method
 
@@ -87,6 +110,8 @@ public class Caml
 	 * | argInt64		| long			| int64
 	 * | argValue		| Value			| *
 	 * | argObject		| Object		| Java.obj
+	 *
+	 * If an exception is thrown, the current call is aborted
 	 */
 	public static native void argUnit()
 		throws ArgumentStackOverflowException;
@@ -125,4 +150,75 @@ public class Caml
 	public static native long callInt64() throws CamlException;
 	public static native Value callValue() throws CamlException;
 	public static native Object callObject() throws CamlException;
+
+	/**
+	 * Calls a function in a single native call
+	 * Faster than `function` + `arg<Type>` + `call<Type>`:
+	 *  the argument stack is not used
+	 *
+	 * `invoke` + one letter per argument,
+	 *  all the arguments and the result have the same type
+	 *
+	 * | Letter	| Java type		| OCaml type
+	 * | ---	| ---			| ---
+	 * | I		| int			| int
+	 * | J		| long			| int (63-bit)
+	 * | D		| double		| float
+	 * | O		| Object		| Java.obj
+	 *
+	 * The arguments types must match the OCaml function
+	 *
+	 * Throws NullPointerException if `f` is null
+	 * Throws CamlException if an OCaml exception is raised
+	 * May throws any exception (with Jthrowable.throw/throw_new)
+	 */
+	public static int invokeI(Callback f, int a)
+		throws CamlException
+	{ return invokeI(f.closure, a); }
+	public static int invokeII(Callback f, int a, int b)
+		throws CamlException
+	{ return invokeII(f.closure, a, b); }
+	public static int invokeIII(Callback f, int a, int b, int c)
+		throws CamlException
+	{ return invokeIII(f.closure, a, b, c); }
+	public static long invokeJ(Callback f, long a)
+		throws CamlException
+	{ return invokeJ(f.closure, a); }
+	public static long invokeJJ(Callback f, long a, long b)
+		throws CamlException
+	{ return invokeJJ(f.closure, a, b); }
+	public static long invokeJJJ(Callback f, long a, long b, long c)
+		throws CamlException
+	{ return invokeJJJ(f.closure, a, b, c); }
+	public static double invokeD(Callback f, double a)
+		throws CamlException
+	{ return invokeD(f.closure, a); }
+	public static double invokeDD(Callback f, double a, double b)
+		throws CamlException
+	{ return invokeDD(f.closure, a, b); }
+	public static double invokeDDD(Callback f, double a, double b, double c)
+		throws CamlException
+	{ return invokeDDD(f.closure, a, b, c); }
+	public static Object invokeO(Callback f, Object a)
+		throws CamlException
+	{ return invokeO(f.closure, a); }
+	public static Object invokeOO(Callback f, Object a, Object b)
+		throws CamlException
+	{ return invokeOO(f.closure, a, b); }
+	public static Object invokeOOO(Callback f, Object a, Object b, Object c)
+		throws CamlException
+	{ return invokeOOO(f.closure, a, b, c); }
+
+	private static native int invokeI(long f, int a);
+	private static native int invokeII(long f, int a, int b);
+	private static native int invokeIII(long f, int a, int b, int c);
+	private static native long invokeJ(long f, long a);
+	private static native long invokeJJ(long f, long a, long b);
+	private static native long invokeJJJ(long f, long a, long b, long c);
+	private static native double invokeD(long f, double a);
+	private static native double invokeDD(long f, double a, double b);
+	private static native double invokeDDD(long f, double a, double b, double c);
+	private static native Object invokeO(long f, Object a);
+	private static native Object invokeOO(long f, Object a, Object b);
+	private static native Object invokeOOO(long f, Object a, Object b, Object c);
 }
@@ -1,16 +1,73 @@
 package juloo.javacaml;
 
+import java.io.PrintStream;
+import java.io.PrintWriter;
+
 /**
  * Thrown by the `Caml.call`* functions after an uncaught OCaml exception
+ *
+ * The OCaml backtrace is kept raw and converted to stack frames
+ *  the first time the stack trace is needed,
+ *  from the OCaml thread (other threads only see the Java frames)
+ * Exceptions registered with `Java.register_stackless` are thrown
+ *  as a preallocated instance, without stack trace
  */
 public class CamlException extends RuntimeException
 {
-	public CamlException(String msg, Throwable cause, StackTraceElement[] caml_stack)
+	// The raw OCaml backtrace, `null` once converted
+	private Value backtrace;
+
+	public CamlException(String msg, Throwable cause, Value backtrace)
+	{
+		super("Uncaught OCaml exception: `" + msg + "`", cause);
+		this.backtrace = backtrace;
+	}
+
+	private CamlException(String msg)
+	{
+		super("Uncaught OCaml exception: `" + msg + "`", null, false, false);
+	}
+
+	protected static CamlException stackless(String msg)
+	{
+		return new CamlException(msg);
+	}
+
+	// Returns `null` if not called from the OCaml thread
+	private static native StackTraceElement[] backtraceElements(Value bt);
+
+	private synchronized void convertBacktrace()
+	{
+		StackTraceElement[] caml_stack;
+
+		if (backtrace == null)
+			return ;
+		caml_stack = backtraceElements(backtrace);
+		if (caml_stack == null)
+			return ;
+		backtrace = null;
+		setStackTrace(concat_stacks(caml_stack, super.getStackTrace()));
+	}
+
+	@Override
+	public StackTraceElement[] getStackTrace()
+	{
+		convertBacktrace();
+		return super.getStackTrace();
+	}
+
+	@Override
+	public void printStackTrace(PrintStream s)
+	{
+		convertBacktrace();
+		super.printStackTrace(s);
+	}
+
+	@Override
+	public void printStackTrace(PrintWriter s)
 	{
-		super("Uncaught OCaml exception: `" + msg + "`");
-		setStackTrace(concat_stacks(caml_stack, getStackTrace()));
-		if (cause != null)
-			initCause(cause);
+		convertBacktrace();
+		super.printStackTrace(s);
 	}
 
 	static StackTraceElement[] concat_stacks(StackTraceElement[] a,
@@ -0,0 +1,169 @@
+package juloo.javacaml;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.AbstractExecutorService;
+import java.util.concurrent.Callable;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+/**
+ * Executor whose tasks run on the OCaml thread
+ * Created by `Jexecutor.create`
+ *
+ * Tasks can be submitted from any thread, they are queued
+ *  and the OCaml side is woken up through a pipe
+ * The OCaml side runs them by batches with `Jexecutor.run`,
+ *  tasks can call OCaml functions (`Caml.call*`)
+ * `submit` returns a CompletableFuture, completed on the OCaml thread
+ */
+public class CamlExecutor extends AbstractExecutorService
+{
+	private final ConcurrentLinkedQueue<Runnable> tasks =
+		new ConcurrentLinkedQueue<Runnable>();
+	// Set if the pipe has been written since the last `run`
+	private final AtomicBoolean signaled = new AtomicBoolean(false);
+	private final int wakeFd;
+	private volatile boolean shutdown = false;
+
+	protected CamlExecutor(int wakeFd)
+	{
+		this.wakeFd = wakeFd;
+	}
+
+	@Override
+	public void execute(Runnable task)
+	{
+		if (task == null)
+			throw new NullPointerException();
+		if (shutdown)
+			throw new RejectedExecutionException("CamlExecutor is shut down");
+		tasks.add(task);
+		if (signaled.compareAndSet(false, true))
+			wake(wakeFd);
+	}
+
+	// The task does not run if the future has been completed
+	//  or cancelled before
+	@Override
+	public <T> CompletableFuture<T> submit(final Callable<T> task)
+	{
+		final CompletableFuture<T> future = new CompletableFuture<T>();
+
+		if (task == null)
+			throw new NullPointerException();
+		execute(new Runnable() {
+			public void run()
+			{
+				if (future.isDone())
+					return ;
+				try
+				{
+					future.complete(task.call());
+				}
+				catch (Throwable e)
+				{
+					future.completeExceptionally(e);
+				}
+			}
+		});
+		return future;
+	}
+
+	@Override
+	public <T> CompletableFuture<T> submit(Runnable task, T result)
+	{
+		if (task == null)
+			throw new NullPointerException();
+		return submit(Executors.callable(task, result));
+	}
+
+	@Override
+	public CompletableFuture<?> submit(Runnable task)
+	{
+		return submit(task, null);
+	}
+
+	// Called from the OCaml thread
+	// Runs at most `max` tasks, returns the number of tasks run
+	// Exceptions thrown by the tasks are passed to the thread's
+	//  uncaught exception handler (`submit` already catches them)
+	protected int run(int max)
+	{
+		Runnable task;
+		int n = 0;
+
+		signaled.set(false);
+		Value.poll();
+		while (n < max && (task = tasks.poll()) != null)
+		{
+			n++;
+			try
+			{
+				task.run();
+			}
+			catch (Throwable e)
+			{
+				Thread t = Thread.currentThread();
+				t.getUncaughtExceptionHandler().uncaughtException(t, e);
+			}
+		}
+		if (!tasks.isEmpty() && signaled.compareAndSet(false, true))
+			wake(wakeFd);
+		return n;
+	}
+
+	@Override
+	public void shutdown()
+	{
+		shutdown = true;
+		if (signaled.compareAndSet(false, true))
+			wake(wakeFd);
+	}
+
+	@Override
+	public List<Runnable> shutdownNow()
+	{
+		List<Runnable> pending = new ArrayList<Runnable>();
+		Runnable task;
+
+		shutdown();
+		while ((task = tasks.poll()) != null)
+			pending.add(task);
+		return pending;
+	}
+
+	@Override
+	public boolean isShutdown()
+	{
+		return shutdown;
+	}
+
+	@Override
+	public boolean isTerminated()
+	{
+		return shutdown && tasks.isEmpty();
+	}
+
+	@Override
+	public boolean awaitTermination(long timeout, TimeUnit unit)
+		throws InterruptedException
+	{
+		long deadline = System.nanoTime() + unit.toNanos(timeout);
+
+		while (!isTerminated())
+		{
+			if (System.nanoTime() >= deadline)
+				return false;
+			Thread.sleep(1);
+		}
+		return true;
+	}
+
+	// Writes to the pipe, does not use the OCaml runtime
+	private static native void wake(int fd);
+}
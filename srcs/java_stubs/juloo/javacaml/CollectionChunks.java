@@ -0,0 +1,93 @@
+package juloo.javacaml;
+
+import java.util.Arrays;
+import java.util.Iterator;
+import java.util.Map;
+
+/**
+ * Read collections by chunks
+ * Used by `Jcollection`, each chunk is an array converted in a single call
+ * The kinds are the same as in `jcollection.ml`
+ */
+public class CollectionChunks
+{
+	static final int OBJECT = 0;
+	static final int STRING = 1;
+	static final int INT = 2;
+	static final int FLOAT = 3;
+
+	// Iterates over an Iterator, an Iterable, the entries of a Map
+	//  or an array
+	protected static Iterator<?> iterator(Object c)
+	{
+		if (c instanceof Iterator)
+			return (Iterator<?>)c;
+		if (c instanceof Iterable)
+			return ((Iterable<?>)c).iterator();
+		if (c instanceof Map)
+			return ((Map<?, ?>)c).entrySet().iterator();
+		if (c instanceof Object[])
+			return Arrays.asList((Object[])c).iterator();
+		throw new IllegalArgumentException("Not a collection: "
+				+ c.getClass().getName());
+	}
+
+	// Reads at most `max` elements, an empty chunk means the end
+	protected static Object next(Iterator<?> it, int max, int kind)
+	{
+		Object[] chunk = new Object[max];
+		int n = 0;
+
+		while (n < max && it.hasNext())
+			chunk[n++] = it.next();
+		return convert(chunk, n, kind);
+	}
+
+	// Same as `next` for the entries of a Map
+	// Returns the chunk of keys and the chunk of values
+	protected static Object[] nextEntries(Iterator<?> it, int max,
+			int keyKind, int valueKind)
+	{
+		Object[] keys = new Object[max];
+		Object[] values = new Object[max];
+		int n = 0;
+
+		while (n < max && it.hasNext())
+		{
+			Map.Entry<?, ?> e = (Map.Entry<?, ?>)it.next();
+			keys[n] = e.getKey();
+			values[n] = e.getValue();
+			n++;
+		}
+		return new Object[] {
+			convert(keys, n, keyKind), convert(values, n, valueKind) };
+	}
+
+	// `INT` and `FLOAT` elements must be `Number`s
+	// A `STRING` chunk is `null` if one of its elements is `null`,
+	//  so that the C side fails before converting anything
+	private static Object convert(Object[] chunk, int n, int kind)
+	{
+		switch (kind)
+		{
+		case STRING:
+			String[] strings = new String[n];
+			for (int i = 0; i < n; i++)
+				if ((strings[i] = (String)chunk[i]) == null)
+					return null;
+			return strings;
+		case INT:
+			long[] ints = new long[n];
+			for (int i = 0; i < n; i++)
+				ints[i] = ((Number)chunk[i]).longValue();
+			return ints;
+		case FLOAT:
+			double[] floats = new double[n];
+			for (int i = 0; i < n; i++)
+				floats[i] = ((Number)chunk[i]).doubleValue();
+			return floats;
+		default:
+			return (n == chunk.length) ? chunk : Arrays.copyOf(chunk, n);
+		}
+	}
+}
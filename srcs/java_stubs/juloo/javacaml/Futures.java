@@ -0,0 +1,36 @@
+package juloo.javacaml;
+
+import java.util.concurrent.CompletionStage;
+import java.util.concurrent.Executor;
+import java.util.concurrent.Future;
+import java.util.function.BiConsumer;
+
+/**
+ * Completion of futures
+ * Used by `Jfuture`, requires Java 8
+ */
+public class Futures
+{
+	// Runs `callback` through `executor` when `future` completes
+	// `future` must be a CompletionStage (eg. a CompletableFuture)
+	//  or be already done
+	protected static void onComplete(Future<?> future,
+			final Executor executor, final Runnable callback)
+	{
+		if (!(future instanceof CompletionStage))
+		{
+			if (!future.isDone())
+				throw new IllegalArgumentException("Not a CompletionStage: "
+						+ future.getClass().getName());
+			executor.execute(callback);
+			return ;
+		}
+		((CompletionStage<?>)future).whenComplete(
+			new BiConsumer<Object, Throwable>() {
+				public void accept(Object result, Throwable exn)
+				{
+					executor.execute(callback);
+				}
+			});
+	}
+}
@@ -0,0 +1,37 @@
+package juloo.javacaml;
+
+/**
+ * Convert string arrays in a single call
+ * Used by `Jarray.of_strings` and `Jarray.to_strings`,
+ *  the characters of all the strings are stored in a single array
+ *  and the string `i` is in the range [offsets[i], offsets[i + 1])
+ */
+public class StringArrays
+{
+	protected static String[] split(char[] data, int[] offsets)
+	{
+		String[] strings = new String[offsets.length - 1];
+
+		for (int i = 0; i < strings.length; i++)
+			strings[i] = new String(data, offsets[i], offsets[i + 1] - offsets[i]);
+		return strings;
+	}
+
+	// `offsets` must have `strings.length + 1` elements
+	// Throws `NullPointerException` if one of the strings is `null`
+	protected static char[] join(String[] strings, int[] offsets)
+	{
+		int length = 0;
+
+		for (int i = 0; i < strings.length; i++)
+		{
+			offsets[i] = length;
+			length += strings[i].length();
+		}
+		offsets[strings.length] = length;
+		char[] data = new char[length];
+		for (int i = 0; i < strings.length; i++)
+			strings[i].getChars(0, strings[i].length(), data, offsets[i]);
+		return data;
+	}
+}
@@ -1,18 +1,79 @@
 package juloo.javacaml;
 
+import java.lang.ref.PhantomReference;
+import java.lang.ref.ReferenceQueue;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.Set;
+
 /**
  * Hold an OCaml value (anything: an int, an object, etc.)
+ * Values are only created from the OCaml side, which holds the runtime lock
+ * The values of the collected objects are released by batches
+ *  the queue is polled when an other Value is created and by `Jexecutor.run`,
+ *  a batch is released when it is full (see `poll`)
+ * `Java.flush_released` also releases the last partial batch (see `collect`)
  */
 public class Value
 {
+	private static final int RELEASE_BATCH = 64;
+
+	private static final ReferenceQueue<Value> queue =
+		new ReferenceQueue<Value>();
+	private static final Set<Handle> live =
+		Collections.synchronizedSet(new HashSet<Handle>());
+	private static final long[] released = new long[RELEASE_BATCH];
+	private static int releasedCount = 0;
+
 	protected long value;
 
-	protected Value(long v) { this.value = v; }
+	protected Value(long v)
+	{
+		this.value = v;
+		poll();
+		live.add(new Handle(this, v));
+	}
 
-	protected native void release();
+	// Moves the values of the collected objects to the batch
+	//  and releases it each time it is full
+	// Must be called from the thread that holds the OCaml runtime lock
+	static void poll()
+	{
+		Handle h;
 
-	protected void finalize()
+		while ((h = (Handle)queue.poll()) != null)
+		{
+			live.remove(h);
+			released[releasedCount++] = h.value;
+			if (releasedCount == RELEASE_BATCH)
+			{
+				release(released, releasedCount);
+				releasedCount = 0;
+			}
+		}
+	}
+
+	// Same as `poll` but also releases the partial batch
+	static void collect()
+	{
+		poll();
+		if (releasedCount > 0)
+		{
+			release(released, releasedCount);
+			releasedCount = 0;
+		}
+	}
+
+	private static native void release(long[] values, int count);
+
+	private static class Handle extends PhantomReference<Value>
 	{
-		release();
+		final long value;
+
+		Handle(Value v, long value)
+		{
+			super(v, queue);
+			this.value = value;
+		}
 	}
 }
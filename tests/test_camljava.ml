@@ -12,6 +12,7 @@ let () =
 	try
 		Test_caml.run ();
 		Test_caml.run ();
+		Test_threads.run ();
 		Test_java.init ();
 		Test_java.run ()
 	with Java.Exception e ->
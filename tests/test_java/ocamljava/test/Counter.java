@@ -0,0 +1,26 @@
+package ocamljava.test;
+
+// Bound with [@java.stubs] in tests/test_ml/test_stubs.ml
+public class Counter
+{
+	public static long total = 0;
+	public String label = "counter";
+	private int count;
+
+	public Counter(int start)
+	{
+		count = start;
+	}
+
+	public int add(int n)
+	{
+		count += n;
+		total += n;
+		return count;
+	}
+
+	public static String name()
+	{
+		return "Counter";
+	}
+}
@@ -194,6 +194,22 @@ public class TestCaml
 		r.run();
 	}
 
+	public static int		runrun_sub(String a, Runnable r, int b)
+	{
+		r.run();
+		return a.length() - b;
+	}
+
+	public static int		sum_many(int a0, int a1, int a2, int a3, int a4,
+			String a5, int a6, int a7, int a8, int a9, String a10, int a11,
+			int a12, int a13, int a14, String a15, int a16, int a17, int a18,
+			int a19, String a20, int a21)
+	{
+		return a0 + a1 + a2 + a3 + a4 + a5.length() + a6 + a7 + a8 + a9
+			+ a10.length() + a11 + a12 + a13 + a14 + a15.length() + a16
+			+ a17 + a18 + a19 + a20.length() + a21;
+	}
+
 	public static int		numrun = 0;
 
 	public static Runnable	getrun()
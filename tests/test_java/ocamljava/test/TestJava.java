@@ -1,6 +1,7 @@
 package ocamljava.test;
 
 import java.io.File;
+import juloo.javacaml.ArgumentStackOverflowException;
 import juloo.javacaml.Caml;
 import juloo.javacaml.Callback;
 import juloo.javacaml.Value;
@@ -171,6 +172,56 @@ public class TestJava
 		Caml.argInt(1);
 		assert Caml.callInt() == 2;
 
+// nested calls
+		Caml.function(Caml.getCallback("test_int"));
+		Caml.argInt(1);
+		Caml.function(Caml.getCallback("test_int"));
+		Caml.argInt(2);
+		Caml.argInt(3);
+		Caml.argInt(Caml.callInt());
+		assert Caml.callInt() == 6;
+
+// call stack size
+		Caml.setCallStackSize(2, 8);
+		Caml.function(Caml.getCallback("test_int"));
+		Caml.argInt(1);
+		try { Caml.setCallStackSize(64, 512); assert false; }
+		catch (IllegalStateException e) {}
+		Caml.function(Caml.getCallback("test_int"));
+		Caml.argInt(2);
+		try { Caml.function(Caml.getCallback("test_int")); assert false; }
+		catch (ArgumentStackOverflowException e) {}
+		Caml.argInt(3);
+		Caml.argInt(Caml.callInt());
+		assert Caml.callInt() == 6;
+		try { Caml.setCallStackSize(0, 8); assert false; }
+		catch (IllegalArgumentException e) {}
+		Caml.setCallStackSize(64, 512);
+
+// invoke
+		Callback test_int = Caml.getCallback("test_int");
+		assert Caml.invokeII(test_int, 12, 3) == 15;
+		assert Caml.invokeI(Caml.getCallback("test_neg"), 4) == -4;
+		assert Caml.invokeIII(Caml.getCallback("test_int3"), 1, 2, 3) == 6;
+		assert Caml.invokeJJ(test_int, 1L << 40, 1) == (1L << 40) + 1;
+		assert Caml.invokeJ(Caml.getCallback("test_neg"), -(1L << 50))
+			== 1L << 50;
+		assert Caml.invokeDD(Caml.getCallback("test_float"), 1.5, 2.0) == 3.5;
+		assert Caml.invokeDDD(Caml.getCallback("test_float3"), 2.0, 3.0, 1.0)
+			== 7.0;
+		assert Caml.invokeOO(Caml.getCallback("test_snd"), "a", "b").equals("b");
+		assert Caml.invokeOO(Caml.getCallback("test_snd"), "a", null) == null;
+		for (int i = 0; i < 100000; i++)
+			assert Caml.invokeII(test_int, i, 1) == i + 1;
+		try
+		{
+			Caml.invokeI(Caml.getCallback("test_raise_int"), 1);
+			assert false;
+		}
+		catch (CamlException e) {}
+		try { Caml.invokeI(null, 1); assert false; }
+		catch (NullPointerException e) {}
+
 // ThreadException
 		new Thread(new Runnable(){
 			public void run()
@@ -187,6 +238,36 @@ public class TestJava
 			}
 		}).start();
 
+// stackless exceptions
+		CamlException not_found = null;
+		for (int i = 0; i < 1000; i++)
+		{
+			try
+			{
+				Caml.invokeI(Caml.getCallback("test_not_found"), i);
+				assert false;
+			}
+			catch (CamlException e)
+			{
+				assert not_found == null || e == not_found;
+				assert e.getStackTrace().length == 0;
+				assert e.getMessage().contains("Not_found");
+				not_found = e;
+			}
+		}
+
+// [@java.stubs] bindings
+		Counter counter = new Counter(1);
+		Caml.function(Caml.getCallback("stubs_add_twice"));
+		Caml.argObject(counter);
+		Caml.argInt(3);
+		assert Caml.callInt() == 7;
+		assert counter.add(0) == 7;
+		Caml.function(Caml.getCallback("stubs_run"));
+		Caml.argUnit();
+		Caml.callUnit();
+		assert Counter.total == 105;
+
 // backtraces
 		try
 		{
@@ -35,6 +35,13 @@ let init () =
 		let cls = Jclass.find_class "java/lang/Exception" in
 		Jthrowable.throw_new cls msg);
 	Callback.register "test_backtrace" h;
+	Callback.register "test_int3" (fun a b c -> a + b + c);
+	Callback.register "test_neg" (fun a -> -a);
+	Callback.register "test_float3" (fun a b c -> a *. b +. c);
+	Callback.register "test_snd" (fun (_ : _ Java.obj) (b : _ Java.obj) -> b);
+	Callback.register "test_raise_int" (fun (_ : int) -> failwith "failuuure");
+	Callback.register "test_not_found" (fun (_ : int) -> raise Not_found);
+	Java.register_stackless Not_found;
 	print_endline "OCaml loaded"
 
 let run () =
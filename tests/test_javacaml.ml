@@ -1,4 +1,5 @@
 let () =
 	Printexc.record_backtrace true;
 	Test_java.init ();
+	Test_stubs.init ();
 	Callback.register "camljava_do_test" Test_caml.run
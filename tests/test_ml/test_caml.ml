@@ -30,6 +30,412 @@ let test_runnable () =
 	runrun (getrun ());
 	assert (numrun () = 4)
 
+(* Calls with many arguments and calls nested in a callback
+	must not clobber the calling stack *)
+let test_calling_stack () =
+	let cls = Jclass.find_class "ocamljava/test/TestCaml" in
+	let sum_many = Jclass.get_meth_static cls "sum_many"
+		"(IIIIILjava/lang/String;IIIILjava/lang/String;IIIILjava/lang/String;\
+		IIIILjava/lang/String;I)I"
+	and runrun_sub = Jclass.get_meth_static cls "runrun_sub"
+		"(Ljava/lang/String;Ljava/lang/Runnable;I)I"
+	and wrap_string = Jclass.get_meth_static cls "wrap_string"
+		"(Ljava/lang/String;)Ljava/lang/String;" in
+	let call_sum_many () =
+		for i = 0 to 21 do
+			if i mod 5 = 0 && i > 0
+			then Jcall.push_string (String.make i 'a')
+			else Jcall.push_int i
+		done;
+		Jcall.call_static_int cls sum_many
+	in
+	let expected = 22 * 21 / 2 in
+	assert (call_sum_many () = expected);
+	let r = Jrunnable.create (fun () ->
+		assert (call_sum_many () = expected);
+		Jcall.push_string "abc";
+		assert (Jcall.call_static_string cls wrap_string = "[abc]"))
+	in
+	Jcall.push_string "abcdef";
+	Jcall.push_object (Jrunnable.to_obj r);
+	Jcall.push_int 2;
+	assert (Jcall.call_static_int cls runrun_sub = 4)
+	(* A lookup that fails between the pushs and the call drops the pushed
+		arguments, the next call must not see them *)
+	for i = 0 to 100 do
+		Jcall.push_string "dropped";
+		Jcall.push_int i;
+		begin try ignore (Jclass.get_meth_static cls "unknown" "()V");
+			assert false
+		with Jclass.Method_not_found _ -> () end
+	done;
+	Jcall.push_string "abc";
+	assert (Jcall.call_static_string cls wrap_string = "[abc]")
+
+(* Objects that die are released later, they must stay usable until then *)
+let test_released () =
+	let cls = Jclass.find_class "ocamljava/test/TestCaml" in
+	let init = Jclass.get_constructor cls "()V" in
+	let keep = Jcall.new_ cls init in
+	for _ = 0 to 10000 do
+		ignore (Jcall.new_ cls init)
+	done;
+	Gc.full_major ();
+	assert (Java.instanceof keep cls);
+	Java.flush_released ();
+	Java.flush_released ();
+	assert (Java.instanceof keep cls)
+
+external jvalue_count : unit -> int = "ocaml_java__jvalue_count"
+
+(* The cells of the Values whose Java object died are released,
+	the number of live cells stays bounded and the live Values are intact *)
+let test_values () =
+	let cls = Jclass.find_class "ocamljava/test/TestCaml"
+	and system = Jclass.find_class "java/lang/System" in
+	let obj = Jcall.new_ cls (Jclass.get_constructor cls "()V")
+	and test_id = Jclass.get_meth cls "test_id"
+		"(Ljuloo/javacaml/Value;)Ljuloo/javacaml/Value;"
+	and gc = Jclass.get_meth_static system "gc" "()V" in
+	let wrap i =
+		Jcall.push_value (i, string_of_int i);
+		Jcall.call_object obj test_id
+	in
+	let base = jvalue_count () in
+	let kept = Array.init 100 wrap in
+	for i = 0 to 20000 do
+		ignore (wrap i)
+	done;
+	(* The references are enqueued by an other Java thread *)
+	let rec collect n =
+		Gc.full_major ();
+		Java.flush_released ();
+		Jcall.call_static_void system gc;
+		Unix.sleepf 0.01;
+		Java.flush_released ();
+		if n > 0 && jvalue_count () - base > 1000 then collect (n - 1)
+	in
+	collect 100;
+	assert (jvalue_count () - base <= 1000);
+	Array.iteri (fun i v ->
+		Jcall.push_object v;
+		assert (Jcall.call_value obj test_id = (i, string_of_int i))
+	) kept
+
+(* Local objects are released with their frame *)
+let test_local_frame () =
+	let cls = Jclass.find_class "ocamljava/test/TestCaml" in
+	let init = Jclass.get_constructor cls "()V"
+	and wrap_string = Jclass.get_meth_static cls "wrap_string"
+		"(Ljava/lang/String;)Ljava/lang/String;"
+	and to_string = Jclass.get_meth (Jclass.find_class "java/lang/Object")
+		"toString" "()Ljava/lang/String;" in
+	let escaped = ref Java.null
+	and kept = ref Java.null in
+	let r = Java.with_local_frame (fun () ->
+		Jcall.push_string "abc";
+		let s = Jcall.call_static_object_local cls wrap_string in
+		assert (Java.to_string s = "[abc]");
+		let obj = Jcall.new_ cls init in
+		let s' = Jcall.call_object_local obj to_string in
+		assert (Java.instanceof s' (Java.objectclass s));
+		Java.with_local_frame (fun () ->
+			Jcall.push_object s;
+			let s = Jcall.call_static_object_local cls wrap_string in
+			assert (Java.to_string s = "[[abc]]"));
+		escaped := s;
+		kept := Java.global s;
+		42)
+	in
+	assert (r = 42);
+	assert (Java.to_string !kept = "[abc]");
+	assert (not (Java.instanceof !escaped (Jclass.find_class "java/lang/String")));
+	assert (not (Java.sameobject !escaped !escaped));
+	(* The failure does not drop the arguments pushed before *)
+	Jcall.push_string "def";
+	begin match Java.to_string !escaped with
+	| exception Failure _	-> ()
+	| _						-> assert false
+	end;
+	assert (Java.to_string (Jcall.call_static_object cls wrap_string) = "[def]");
+	(* Outside of a frame, the result is a normal object *)
+	Jcall.push_string "abc";
+	let s = Jcall.call_static_object_local cls wrap_string in
+	assert (Java.to_string s = "[abc]")
+
+(* Strings around the sizes of the ASCII blocks and of the stack buffer,
+	with non-ASCII chars at different positions *)
+let test_string_convertions () =
+	let cls = Jclass.find_class "ocamljava/test/TestCaml" in
+	let wrap_string = Jclass.get_meth_static cls "wrap_string"
+		"(Ljava/lang/String;)Ljava/lang/String;" in
+	let test s =
+		Jcall.push_string s;
+		assert (Jcall.call_static_string cls wrap_string = "[" ^ s ^ "]")
+	in
+	List.iter (fun len ->
+		let s = String.make len 'a' in
+		test s;
+		List.iter (fun c ->
+			test (s ^ c);
+			test (c ^ s);
+			if len > 0 then test (String.sub s 0 (len / 2) ^ c ^ s)
+		) [ "\xC3\xA9"; "\xE2\x9C\x88"; "\x00" ]
+	) [ 0; 1; 7; 8; 15; 16; 17; 31; 254; 255; 256; 257; 1000 ];
+	let big = String.init (4 * 1024 * 1024) (fun i ->
+		if i mod 1000 = 999 then '!' else Char.chr (97 + i mod 26)) in
+	test big;
+	test (big ^ "\xE2\x9C\x88" ^ big)
+
+(* Bigarrays and direct buffers share their data *)
+let test_buffer () =
+	let open Bigarray in
+	let byte_buffer = Jclass.find_class "java/nio/ByteBuffer" in
+	let get = Jclass.get_meth byte_buffer "get" "(I)B"
+	and put = Jclass.get_meth byte_buffer "put" "(IB)Ljava/nio/ByteBuffer;"
+	and allocate_direct = Jclass.get_meth_static byte_buffer "allocateDirect"
+		"(I)Ljava/nio/ByteBuffer;" in
+	let ba = Array1.create char c_layout 16 in
+	Array1.fill ba 'a';
+	let buffer = Jbuffer.of_bigarray ba in
+	Jcall.push_int 3;
+	assert (Jcall.call_byte buffer get = Char.code 'a');
+	Jcall.push_int 5;
+	Jcall.push_byte (Char.code 'z');
+	ignore (Jcall.call_object buffer put);
+	assert (Array1.get ba 5 = 'z');
+	Jcall.push_int 64;
+	let direct = Jcall.call_static_object byte_buffer allocate_direct in
+	let ba = Jbuffer.to_bigarray int32 direct in
+	assert (Array1.dim ba = 16);
+	let ba = Jbuffer.to_bigarray char direct in
+	Array1.set ba 7 'x';
+	Jcall.push_int 7;
+	assert (Jcall.call_byte direct get = Char.code 'x');
+	let sub = Jbuffer.sub ba 4 8 in
+	Gc.full_major ();
+	Java.flush_released ();
+	Array1.set sub 4 'y';
+	Jcall.push_int 8;
+	assert (Jcall.call_byte direct get = Char.code 'y');
+	begin match Jbuffer.to_bigarray char Java.null with
+	| exception Failure _	-> ()
+	| _						-> assert false
+	end
+
+(* Slices are copied with a single JNI call *)
+let test_jarray_blit () =
+	let a = Jarray.of_ints (Array.init 100 (fun i -> i - 50)) in
+	assert (Jarray.to_ints a = Array.init 100 (fun i -> i - 50));
+	let dst = Array.make 10 0 in
+	Jarray.blit_to_array_int a 20 dst 5 5;
+	assert (dst = [| 0; 0; 0; 0; 0; -30; -29; -28; -27; -26 |]);
+	Jarray.blit_of_array_int [| 1; 2; 3 |] 1 a 98 2;
+	assert (Jarray.get_int a 98 = 2 && Jarray.get_int a 99 = 3);
+	let must_fail f =
+		match f () with
+		| exception Invalid_argument _	-> ()
+		| _								-> assert false
+	in
+	must_fail (fun () -> Jarray.blit_to_array_int a 95 dst 0 6);
+	must_fail (fun () -> Jarray.blit_to_array_int a 0 dst 6 5);
+	must_fail (fun () -> Jarray.blit_of_array_int dst (-1) a 0 1);
+	must_fail (fun () -> Jarray.fill_int a 0 101 0);
+	must_fail (fun () -> Jarray.sub_int a 50 (-1));
+	Jarray.fill_int a 10 5 42;
+	assert (Jarray.to_ints (Jarray.sub_int a 9 7) = [| -41; 42; 42; 42; 42; 42; -35 |]);
+	let a = Jarray.of_longs [| 1L; Int64.max_int; Int64.min_int |] in
+	let dst = Array.make 4 0L in
+	Jarray.blit_to_array_long a 1 dst 2 2;
+	assert (dst = [| 0L; 0L; Int64.max_int; Int64.min_int |]);
+	let a = Jarray.of_doubles [| 0.5; 1.5; 2.5 |] in
+	assert (Jarray.to_doubles (Jarray.sub_double a 1 2) = [| 1.5; 2.5 |]);
+	Jarray.fill_double a 0 3 (-1.);
+	assert (Jarray.to_doubles a = [| -1.; -1.; -1. |]);
+	let a = Jarray.of_chars [| 'a'; 'b'; 'c' |] in
+	assert (Jarray.to_chars a = [| 'a'; 'b'; 'c' |]);
+	let ints = Array.init 100 (fun i -> i * 600 - 30000) in
+	assert (Jarray.to_shorts (Jarray.of_shorts_checked ints) = ints);
+	must_fail (fun () -> Jarray.of_shorts_checked (Array.append ints [| 32768 |]));
+	must_fail (fun () -> Jarray.of_bytes_checked (Array.init 20 (fun i -> i * 8)));
+	must_fail (fun () -> Jarray.of_ints_checked [| 0; 1 lsl 40 |]);
+	assert (Jarray.to_bytes (Jarray.of_bytes [| 0x1ff; -129 |]) = [| -1; 127 |]);
+	let bytes = Array.init 300 (fun i -> i - 150) in
+	assert (Jarray.to_shorts (Jarray.of_shorts bytes) = bytes);
+	let open Bigarray in
+	let ba = Jarray.to_bigarray_short (Jarray.of_shorts [| 1; -2; 3 |]) in
+	assert (Array1.dim ba = 3 && Array1.get ba 1 = -2);
+	let ba = Array1.of_array float64 c_layout [| 1.; 2.; 3. |] in
+	assert (Jarray.to_doubles (Jarray.of_bigarray_double ba) = [| 1.; 2.; 3. |]);
+	let ba = Array1.of_array int32 c_layout [| 7l; -8l |] in
+	assert (Jarray.to_int32s (Jarray.of_bigarray_int32 ba) = [| 7l; -8l |])
+
+(* String and object arrays are converted in a single call *)
+let test_jarray_objects () =
+	let strings = Array.init 10000 (fun i ->
+		match i mod 4 with
+		| 0		-> ""
+		| 1		-> string_of_int i
+		| 2		-> "\xC3\xA9t\xC3\xA9 " ^ string_of_int i
+		| _		-> String.make (i mod 300) 'x') in
+	let a = Jarray.of_strings strings in
+	assert (Jarray.length a = 10000);
+	assert (Jarray.get_string a 2 = "\xC3\xA9t\xC3\xA9 2");
+	assert (Jarray.to_strings a = strings);
+	assert (Jarray.to_strings (Jarray.of_strings [||]) = [||]);
+	begin match Jarray.to_strings (Jarray.create_string 3) with
+	| exception Failure _	-> ()
+	| _						-> assert false
+	end;
+	let cls = Jclass.find_class "java/lang/Object" in
+	let objs = Array.init 1000 (fun i ->
+		if i mod 7 = 0 then Java.null else Jarray.to_obj a) in
+	let a' = Jarray.of_objects cls objs in
+	let objs' = Jarray.to_objects a' in
+	assert (Array.length objs' = 1000);
+	Array.iteri (fun i obj ->
+		if i mod 7 = 0 then assert (obj == Java.null)
+		else assert (Java.equals obj (Jarray.to_obj a))
+	) objs';
+	let string_cls = Jclass.find_class "java/lang/String" in
+	match Jarray.of_objects string_cls [| Jarray.to_obj a |] with
+	| exception Invalid_argument _	-> ()
+	| _								-> assert false
+
+(* Collections are read by chunks *)
+let test_collection () =
+	let integer = Jclass.find_class "java/lang/Integer" in
+	let value_of = Jclass.get_meth_static integer "valueOf"
+		"(I)Ljava/lang/Integer;" in
+	let box i = Jcall.push_int i; Jcall.call_static_object integer value_of in
+	let array_list = Jclass.find_class "java/util/ArrayList" in
+	let list = Jcall.new_ array_list
+		(Jclass.get_constructor array_list "()V") in
+	let add = Jclass.get_meth array_list "add" "(Ljava/lang/Object;)Z" in
+	for i = 0 to 999 do
+		Jcall.push_object (box (i * 3));
+		assert (Jcall.call_bool list add)
+	done;
+	let expected = Array.init 1000 (fun i -> i * 3) in
+	assert (Jcollection.to_array Jcollection.int list = expected);
+	assert (Jcollection.to_list Jcollection.float list
+		= Array.to_list (Array.map float_of_int expected));
+	let sum = ref 0 in
+	Jcollection.iter Jcollection.int (fun i -> sum := !sum + i) list;
+	assert (!sum = Array.fold_left (+) 0 expected);
+	let rec take n seq =
+		match seq () with
+		| Seq.Cons (x, tl) when n > 0	-> x :: take (n - 1) tl
+		| _								-> []
+	in
+	assert (take 3 (Jcollection.to_seq Jcollection.int list) = [ 0; 3; 6 ]);
+	let strings = Jarray.of_strings [| "a"; "b"; "c" |] in
+	assert (Jcollection.to_list Jcollection.string (Jarray.to_obj strings)
+		= [ "a"; "b"; "c" ]);
+	assert (Array.length (Jcollection.to_array Jcollection.obj list) = 1000);
+	let hash_map = Jclass.find_class "java/util/HashMap" in
+	let map = Jcall.new_ hash_map (Jclass.get_constructor hash_map "()V") in
+	let put = Jclass.get_meth hash_map "put"
+		"(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;" in
+	for i = 0 to 599 do
+		Jcall.push_string (string_of_int i);
+		Jcall.push_object (box i);
+		ignore (Jcall.call_object map put)
+	done;
+	let tbl = Jcollection.to_hashtbl Jcollection.string Jcollection.int map in
+	assert (Hashtbl.length tbl = 600);
+	Hashtbl.iter (fun k v -> assert (k = string_of_int v)) tbl;
+	Jcall.push_object Java.null;
+	Jcall.push_object (box 0);
+	ignore (Jcall.call_object map put);
+	begin match Jcollection.to_hashtbl Jcollection.string Jcollection.int map with
+	| exception Failure _	-> ()
+	| _						-> assert false
+	end;
+	match Jcollection.to_array Jcollection.int (box 1) with
+	| exception Java.Exception _	-> ()
+	| _								-> assert false
+
+let test_executor () =
+	let executor = Jexecutor.create () in
+	let obj = Jexecutor.to_obj executor in
+	let cls = Jclass.find_class "java/util/concurrent/ExecutorService" in
+	let execute = Jclass.get_meth cls "execute" "(Ljava/lang/Runnable;)V" in
+	let submit = Jclass.get_meth cls "submit"
+		"(Ljava/lang/Runnable;)Ljava/util/concurrent/Future;" in
+	let shutdown = Jclass.get_meth cls "shutdown" "()V" in
+	let is_done = Jclass.get_meth (Jclass.find_class
+		"java/util/concurrent/Future") "isDone" "()Z" in
+	let readable () =
+		let r, _, _ = Unix.select [ Jexecutor.fd executor ] [] [] 0. in
+		r <> []
+	in
+	let count = ref 0 in
+	let task = Jrunnable.create (fun () -> incr count) in
+	assert (not (readable ()));
+	assert (Jexecutor.run executor = 0);
+	for _i = 1 to 100 do
+		Jcall.push_object (Jrunnable.to_obj task);
+		Jcall.call_void obj execute
+	done;
+	Jcall.push_object (Jrunnable.to_obj task);
+	let future = Jcall.call_object obj submit in
+	assert (Java.instanceof future
+		(Jclass.find_class "java/util/concurrent/CompletableFuture"));
+	assert (readable ());
+	assert (not (Jcall.call_bool future is_done));
+	assert (Jexecutor.run executor = 64);
+	assert (!count = 64);
+	assert (readable ());
+	assert (Jexecutor.run ~max:100 executor = 37);
+	assert (!count = 101);
+	assert (Jcall.call_bool future is_done);
+	assert (not (readable ()));
+	Jcall.push_object (Jrunnable.to_obj task);
+	Jcall.call_void obj execute;
+	Jcall.call_void obj shutdown;
+	Jexecutor.loop executor;
+	assert (!count = 102)
+
+let test_future () =
+	let executor = Jexecutor.create () in
+	let string = Jclass.find_class "java/lang/String" in
+	let string_new = Jclass.get_constructor string "(Ljava/lang/String;)V" in
+	let new_string s = Jcall.push_string s; Jcall.new_ string string_new in
+	let exn_cls = Jclass.find_class "java/lang/RuntimeException" in
+	let exn_new = Jclass.get_constructor exn_cls "(Ljava/lang/String;)V" in
+	let new_exn msg =
+		Jcall.push_string msg;
+		(Obj.magic (Jcall.new_ exn_cls exn_new) : Java.jthrowable)
+	in
+	let outcome = ref None in
+	let a = Jfuture.create () in
+	Jfuture.on_complete executor a (fun r -> outcome := Some r);
+	assert (Jfuture.poll a = None);
+	assert (Jexecutor.run executor = 0);
+	let v = new_string "abc" in
+	Jfuture.complete a v;
+	assert (Jfuture.is_done a);
+	assert (!outcome = None);
+	assert (Jexecutor.run executor = 1);
+	(match !outcome with
+	| Some (Ok v')	-> assert (Java.sameobject v v')
+	| _				-> assert false);
+	let b = Jfuture.of_deferred (fun k -> k (Error (new_exn "failed"))) in
+	(match Jfuture.poll b with
+	| Some (Error e)	-> assert (Jthrowable.get_message e = "failed")
+	| _					-> assert false);
+	outcome := None;
+	Jfuture.on_complete executor (Jfuture.of_obj (Jfuture.to_obj b))
+		(fun r -> outcome := Some r);
+	assert (Jexecutor.run executor = 1);
+	(match !outcome with
+	| Some (Error _)	-> ()
+	| _					-> assert false);
+	match Jfuture.of_obj v with
+	| exception Failure _	-> ()
+	| _						-> assert false
+
 let run () =
 	let open Jclass in
 
@@ -56,6 +462,9 @@ let run () =
 	push_int 4;
 	assert (call_int obj method_test = 5);
 
+	assert (call_static_int_i cls method_static_test 1 = ~-41);
+	assert (call_int_ii obj method_test 1 4 = 5);
+
 	assert (read_field_int obj field_a = 42);
 	assert (read_field_string obj field_b = "abc");
 	assert (read_field_static_int cls method_static_field_a = 42);
@@ -219,6 +628,13 @@ let run () =
 	push_object null;
 	assert (call_value_opt obj id_obj_m = None);
 
+	assert (call_object_o obj id_obj_m null == null);
+	begin try
+		ignore (call_string_o obj id_obj_m null);
+		assert false
+	with Failure _ -> ()
+	end;
+
 	begin try
 		call_void obj (get_meth cls "raise" "()V");
 		assert false
@@ -282,6 +698,24 @@ let run () =
 	assert (not (equals (int_new "1") (int_new "2")));
 	must_fail (fun () -> equals null obj);
 	assert (hash_code null = 0);
+	assert (hash_code (int_new "-42") = -42);
+	assert (Hashtbl.hash (int_new "123") = Hashtbl.hash (int_new "123"));
+	assert (identity_hash null = 0);
+	assert (identity_hash obj = identity_hash obj);
+
+	let tbl = Obj_table.create 16 in
+	let a = int_new "1" and a' = int_new "1" in
+	Obj_table.add tbl a "a";
+	Obj_table.add tbl obj "obj";
+	assert (Obj_table.find tbl a = "a");
+	assert (Obj_table.find tbl obj = "obj");
+	assert (not (Obj_table.mem tbl a'));
+	assert (not (Obj_table.mem tbl null));
+	Obj_table.replace tbl a' "a'";
+	assert (Obj_table.length tbl = 3);
+	assert (Obj_table.find tbl a' = "a'");
+	Obj_table.remove tbl a;
+	assert (Obj_table.find_opt tbl a = None);
 	must_fail (fun () -> to_string null);
 
 	assert (to_string (int_new "123") = "123");
@@ -300,4 +734,15 @@ let run () =
 
 	print_endline @@ test_rec_a "-> ";
 
-	test_runnable ()
+	test_runnable ();
+	test_calling_stack ();
+	test_released ();
+	test_values ();
+	test_local_frame ();
+	test_string_convertions ();
+	test_buffer ();
+	test_jarray_blit ();
+	test_jarray_objects ();
+	test_collection ();
+	test_executor ();
+	test_future ()
@@ -22,6 +22,8 @@ object
 
 	method [@static] get_string : string = "get_string"
 	method [@static] wrap_string : string -> string = "wrap_string"
+	val [@static] mutable static_interned : string [@java.interned]
+		= "test_static_string"
 
 	val [@static] mutable numrun : int = "numrun"
 	method [@static] runrun : runnable -> unit = "runrun"
@@ -86,6 +88,56 @@ let test_runnable () =
 	Test.runrun r;
 	assert (Test.get'numrun () = 1)
 
+(* Eager classes are resolved when the module is initialized,
+	after the JVM is started *)
+let test_eager () =
+	let module M =
+	struct
+		class%java [@java.eager] jinteger "java.lang.Integer" =
+		object
+			val [@static] max_value : int = "MAX_VALUE"
+			initializer (create : int -> _)
+			method int_value : int = "intValue"
+			method [@static] of_int : int -> jinteger = "valueOf"
+		end
+	end in
+	let open M in
+	assert (Jinteger.get'max_value () = 0x7FFFFFFF);
+	assert (Jinteger.int_value (Jinteger.create 42) = 42);
+	assert (Jinteger.int_value (Jinteger.of_int 12) = 12);
+	let module Missing () =
+	struct
+		class%java [@java.eager] jinteger "java.lang.Integer" =
+		object
+			method missing : int = "missing"
+		end
+	end in
+	begin match let module M = Missing () in M.Jinteger.__class () with
+	| exception Jclass.Method_not_found ("missing", "()I")	-> ()
+	| _														-> assert false
+	end
+
+(* Interned strings are converted once, the same OCaml string is returned
+	for the same Java String *)
+let test_interned () =
+	let old = Test.get'static_interned () in
+	Java.Intern.set_size 16;
+	Java.Intern.reset_stats ();
+	Test.set'static_interned "abc";
+	Test.set'static_interned "abc";
+	let a = Test.get'static_interned () in
+	let b = Test.get'static_interned () in
+	assert (a = "abc" && a == b);
+	let open Java.Intern in
+	let { to_java_hits; to_java_misses; of_java_hits; of_java_misses } =
+		stats () in
+	assert (to_java_hits = 1 && to_java_misses = 1);
+	assert (of_java_hits = 1 && of_java_misses = 1);
+	set_size 0;
+	assert (size () = 0);
+	assert (Test.get'static_interned () = "abc");
+	Test.set'static_interned old
+
 let run () =
 	let _ = Test.create_default () in
 	let obj = Test.create 11 "x" in
@@ -148,5 +200,7 @@ let run () =
 
 	test_charsequence ();
 	test_runnable ();
+	test_eager ();
+	test_interned ();
 
 	()
@@ -0,0 +1,32 @@
+(* The generated C is compiled into this library (see ./dune)
+	The class is resolved when the module is initialized,
+		so it can only be linked where the JVM is started first (javacaml) *)
+
+class%java [@java.stubs] counter "ocamljava.test.Counter" =
+object
+	initializer (create : int -> _)
+	val [@static] mutable total : long = "total"
+	val mutable label : string = "label"
+	method add : int -> int = "add"
+	method [@static] name : string = "name"
+end
+
+(* Called from Java with a counter created on the Java side *)
+let add_twice c n =
+	let c = Counter.of_obj c in
+	ignore (Counter.add c n);
+	Counter.add c n
+
+let run () =
+	Counter.set'total 100L;
+	let c = Counter.create 10 in
+	assert (Counter.add c 5 = 15);
+	assert (Counter.get'total () = 105L);
+	assert (Counter.get'label c = "counter");
+	Counter.set'label c "renamed";
+	assert (Counter.get'label c = "renamed");
+	assert (Counter.name () = "Counter")
+
+let init () =
+	Callback.register "stubs_add_twice" add_twice;
+	Callback.register "stubs_run" run
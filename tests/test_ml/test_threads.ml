@@ -0,0 +1,17 @@
+(* Call Java from several OCaml threads at once *)
+
+let run () =
+	let cls = Jclass.find_class "ocamljava/test/TestCaml" in
+	let m_test = Jclass.get_meth cls "test" "(II)I"
+	and init = Jclass.get_constructor cls "()V" in
+	let worker i () =
+		let obj = Jcall.new_ cls init in
+		for j = 0 to 1000 do
+			Jcall.push_int i;
+			Jcall.push_int j;
+			assert (Jcall.call_int obj m_test = i + j);
+			Thread.yield ()
+		done
+	in
+	List.init 8 (fun i -> Thread.create (worker i) ())
+	|> List.iter Thread.join